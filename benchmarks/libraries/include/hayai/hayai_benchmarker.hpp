@@ -317,8 +317,8 @@ namespace hayai
         static void ShuffleTests()
         {
             Benchmarker& instance = Instance();
-            random_shuffle(instance._tests.begin(),
-                           instance._tests.end());
+            hayai::random_shuffle(instance._tests.begin(),
+                                  instance._tests.end());
         }
     private:
         /// Calibration model.
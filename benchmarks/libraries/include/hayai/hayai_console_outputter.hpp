@@ -208,6 +208,20 @@ namespace hayai
                           result.RunsPerSecondAverage(),
                           "runs/s");
 
+            _stream << Console::TextBlue << "[ LATENCY  ] "
+                    << Console::TextDefault
+                    << std::setprecision(3)
+                    << "       Median time: "
+                    << result.RunTimePercentile(50.0) / 1000.0 << " us"
+                    << std::endl;
+
+            PAD("95th percentile: " <<
+                result.RunTimePercentile(95.0) / 1000.0 << " us");
+            PAD("99th percentile: " <<
+                result.RunTimePercentile(99.0) / 1000.0 << " us");
+            PAD("Maximum: " <<
+                result.RunTimeMaximum() / 1000.0 << " us");
+
             _stream << Console::TextBlue << "[ITERATIONS] "
                     << Console::TextDefault
                     << std::setprecision(3)
@@ -37,7 +37,13 @@ namespace hayai
     ///         "disabled": false,
     ///         "runs": [{
     ///             "duration": 3801.889831
-    ///         }, ..]
+    ///         }, ..],
+    ///         "percentiles": {
+    ///             "p50": 3790.120347,
+    ///             "p95": 3811.540012,
+    ///             "p99": 3812.007865,
+    ///             "max": 3812.007865
+    ///         }
     ///     }, {
     ///         "fixture": "DeliveryMan",
     ///         "name": "DisabledTest",
@@ -46,7 +52,8 @@ namespace hayai
     ///     }, ..]
     /// }
     ///
-    /// All durations are represented as milliseconds.
+    /// All durations are represented as milliseconds. Percentiles are of run
+    /// durations, using the nearest-rank method.
     class JsonOutputter
         :   public Outputter
     {
@@ -163,7 +170,37 @@ namespace hayai
             }
 
             _stream <<
-                JSON_ARRAY_END;
+                JSON_ARRAY_END
+
+                JSON_VALUE_SEPARATOR
+
+                JSON_STRING_BEGIN "percentiles" JSON_STRING_END
+                JSON_NAME_SEPARATOR
+                JSON_OBJECT_BEGIN;
+
+            static const struct { const char* name; double percentile; }
+                percentiles[] = {
+                    { "p50", 50.0 }, { "p95", 95.0 },
+                    { "p99", 99.0 }, { "max", 100.0 }
+                };
+
+            for (std::size_t i = 0;
+                 i < sizeof(percentiles) / sizeof(percentiles[0]);
+                 ++i)
+            {
+                if (i)
+                    _stream << JSON_VALUE_SEPARATOR;
+
+                _stream << JSON_STRING_BEGIN << percentiles[i].name
+                        << JSON_STRING_END JSON_NAME_SEPARATOR
+                        << std::fixed
+                        << std::setprecision(6)
+                        << (result.RunTimePercentile(
+                                percentiles[i].percentile) / 1000000.0);
+            }
+
+            _stream <<
+                JSON_OBJECT_END;
 
             EndTestObject();
         }
@@ -1,5 +1,7 @@
 #ifndef __HAYAI_TESTRESULT
 #define __HAYAI_TESTRESULT
+#include <algorithm>
+#include <cmath>
 #include <vector>
 #include <stdexcept>
 #include <limits>
@@ -43,6 +45,9 @@ namespace hayai
 
                 ++runIt;
             }
+
+            _sortedRunTimes = _runTimes;
+            std::sort(_sortedRunTimes.begin(), _sortedRunTimes.end());
         }
 
 
@@ -81,6 +86,29 @@ namespace hayai
         }
 
 
+        /// Time per run at the given percentile.
+
+        /// Uses the nearest-rank method: the result is the smallest run time
+        /// such that at least the given percentage of runs took no longer.
+        ///
+        /// @param percentile Percentile in [0, 100].
+        inline double RunTimePercentile(double percentile) const
+        {
+            if (_sortedRunTimes.empty())
+                return 0.0;
+
+            std::size_t rank = static_cast<std::size_t>(
+                std::ceil(percentile / 100.0 *
+                          double(_sortedRunTimes.size())));
+            if (rank < 1)
+                rank = 1;
+            if (rank > _sortedRunTimes.size())
+                rank = _sortedRunTimes.size();
+
+            return static_cast<double>(_sortedRunTimes[rank - 1]);
+        }
+
+
         /// Average runs per second.
         inline double RunsPerSecondAverage() const
         {
@@ -123,6 +151,15 @@ namespace hayai
         }
 
 
+        /// Time per iteration at the given percentile.
+
+        /// @param percentile Percentile in [0, 100].
+        inline double IterationTimePercentile(double percentile) const
+        {
+            return RunTimePercentile(percentile) / double(_iterations);
+        }
+
+
         /// Average iterations per second.
         inline double IterationsPerSecondAverage() const
         {
@@ -144,6 +181,7 @@ namespace hayai
         }
     private:
         std::vector<uint64_t> _runTimes;
+        std::vector<uint64_t> _sortedRunTimes;
         std::size_t _iterations;
         uint64_t _timeTotal;
         uint64_t _timeRunMin;
@@ -0,0 +1,160 @@
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <hayai/hayai.hpp>
+
+#include <cost_matrix_file.h>
+
+
+using rharel::hungarian_algorithm::CostEncoding;
+using rharel::hungarian_algorithm::CostMatrixReader;
+using rharel::hungarian_algorithm::CostMatrixView;
+using rharel::hungarian_algorithm::CostMatrixWriter;
+
+
+/// The number of matrices in the benchmark batch.
+const unsigned int batch_size  = 100;
+/// The size of each matrix in the benchmark batch.
+const unsigned int matrix_size = 100;
+
+/// A batch of random cost matrices (fixed seed), stored row-major.
+const std::vector<std::vector<unsigned int>>& batch()
+{
+    static std::vector<std::vector<unsigned int>> matrices;
+    if (matrices.empty())
+    {
+        std::mt19937 random(0);
+        std::uniform_int_distribution<unsigned int> random_cost(0, 1000);
+
+        matrices.resize(batch_size);
+        for (auto& C : matrices)
+        {
+            C.resize(matrix_size * matrix_size);
+            for (auto& cost : C) { cost = random_cost(random); }
+        }
+    }
+    return matrices;
+}
+/// Writes the batch with the specified encoding.
+std::string write_batch(const CostEncoding encoding)
+{
+    std::ostringstream output(std::ios::binary);
+    CostMatrixWriter   writer(output);
+    std::vector<const unsigned int*> C_row_pointers(matrix_size);
+    for (const auto& C : batch())
+    {
+        for (unsigned int i = 0; i < matrix_size; ++i) 
+        { 
+            C_row_pointers[i] = &C[i * matrix_size]; 
+        }
+        writer.write(matrix_size, C_row_pointers.data(), encoding);
+    }
+    return output.str();
+}
+/// Writes the batch as whitespace-separated text, each matrix preceded by
+/// its size.
+std::string write_batch_as_text()
+{
+    std::ostringstream output;
+    for (const auto& C : batch())
+    {
+        output << matrix_size << '\n';
+        for (unsigned int i = 0; i < matrix_size; ++i)
+        {
+            for (unsigned int j = 0; j < matrix_size; ++j)
+            {
+                output << C[i * matrix_size + j] << ' ';
+            }
+            output << '\n';
+        }
+    }
+    return output.str();
+}
+/// Reads every cost of a written batch, and returns their sum.
+unsigned long long read_batch(const std::string& bytes)
+{
+    CostMatrixReader reader(
+        reinterpret_cast<const unsigned char*>(bytes.data()), bytes.size()
+    );
+    unsigned long long sum = 0;
+    CostMatrixView     view;
+    while (reader.next(view))
+    {
+        for (unsigned int i = 0; i < view.size(); ++i)
+        {
+            for (unsigned int j = 0; j < view.size(); ++j) { sum += view(i, j); }
+        }
+    }
+    return sum;
+}
+/// Parses every cost of a batch written as text, and returns their sum.
+unsigned long long read_batch_as_text(const std::string& text)
+{
+    std::istringstream input(text);
+    std::vector<unsigned int> C;
+    unsigned long long sum = 0;
+    unsigned int n;
+    while (input >> n)
+    {
+        C.resize(n * n);
+        for (auto& cost : C) { input >> cost; sum += cost; }
+    }
+    return sum;
+}
+
+/// Prevents the compiler from discarding benchmarked results.
+volatile unsigned long long benchmark_sink;
+
+BENCHMARK(Cost_Matrix_File_Write,  text,         10, 10)
+{ 
+    benchmark_sink = write_batch_as_text().size(); 
+}
+BENCHMARK(Cost_Matrix_File_Write,  uint32,       10, 10)
+{ 
+    benchmark_sink = write_batch(CostEncoding::UInt32).size(); 
+}
+BENCHMARK(Cost_Matrix_File_Write,  uint16,       10, 10)
+{ 
+    benchmark_sink = write_batch(CostEncoding::UInt16).size(); 
+}
+BENCHMARK(Cost_Matrix_File_Write,  varint,       10, 10)
+{ 
+    benchmark_sink = write_batch(CostEncoding::Varint).size(); 
+}
+BENCHMARK(Cost_Matrix_File_Write,  delta_varint, 10, 10)
+{ 
+    benchmark_sink = write_batch(CostEncoding::DeltaVarint).size(); 
+}
+
+BENCHMARK(Cost_Matrix_File_Read,   text,         10, 10)
+{
+    static const std::string text = write_batch_as_text();
+    benchmark_sink = read_batch_as_text(text);
+}
+BENCHMARK(Cost_Matrix_File_Read,   uint32,       10, 10)
+{
+    static const std::string bytes = write_batch(CostEncoding::UInt32);
+    benchmark_sink = read_batch(bytes);
+}
+BENCHMARK(Cost_Matrix_File_Read,   uint16,       10, 10)
+{
+    static const std::string bytes = write_batch(CostEncoding::UInt16);
+    benchmark_sink = read_batch(bytes);
+}
+BENCHMARK(Cost_Matrix_File_Read,   varint,       10, 10)
+{
+    static const std::string bytes = write_batch(CostEncoding::Varint);
+    benchmark_sink = read_batch(bytes);
+}
+BENCHMARK(Cost_Matrix_File_Read,   delta_varint, 10, 10)
+{
+    static const std::string bytes = write_batch(CostEncoding::DeltaVarint);
+    benchmark_sink = read_batch(bytes);
+}
+
+BENCHMARK(Cost_Matrix_File_Round_Trip, varint,   10, 10)
+{
+    benchmark_sink = read_batch(write_batch(CostEncoding::Varint));
+}
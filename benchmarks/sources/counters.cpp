@@ -0,0 +1,192 @@
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <vector>
+
+#include <hayai/hayai.hpp>
+
+#include <hungarian_algorithm.h>
+
+#include "instances.h"
+#include "performance_counters.h"
+
+
+using rharel::hungarian_algorithm::Problem;
+using rharel::hungarian_algorithm::solve_for_minimum_cost_assignment_lazily;
+
+
+/// The number of steps of the Munkres procedure, including Step::Done.
+constexpr unsigned int step_count = 7;
+
+/// Returns the counters of the benchmarking thread, opening them on first
+/// use.
+PerformanceCounters& counters()
+{
+    static PerformanceCounters counters;
+    static bool is_reported = false;
+    if (!is_reported)
+    {
+        is_reported = true;
+        if (!counters.is_any_available())
+        {
+            std::cout << "Hardware performance counters are unavailable; "
+                      << "counts will be reported as zero." << std::endl;
+        }
+    }
+    return counters;
+}
+
+/// Accumulates counts over the runs of one benchmark.
+struct Tally
+{
+    unsigned int  run_count = 0;
+    CounterValues solve;
+    CounterValues steps[step_count];
+    unsigned long long step_invocations[step_count] = {};
+
+    /// Prints the average counts per solve and, if any were recorded, per
+    /// step, then resets the tally.
+    void report_and_reset()
+    {
+        std::cout << "[ COUNTERS ] Average per solve, over " << run_count
+                  << (run_count == 1 ? " run" : " runs") << ":" << std::endl
+                  << std::setw(22) << "";
+        for (unsigned int k = 0; k < counter_count; ++k)
+        {
+            std::cout << std::setw(15) << name(static_cast<Counter>(k));
+        }
+        std::cout << std::endl;
+
+        print_row("solve", solve);
+        for (unsigned int s = 1; s < step_count; ++s)
+        {
+            if (step_invocations[s] == 0) { continue; }
+
+            std::ostringstream label;
+            label << "step " << s << " (x"
+                  << step_invocations[s] / run_count << ")";
+            print_row(label.str().c_str(), steps[s]);
+        }
+        *this = Tally();
+    }
+
+    private:
+    void print_row(const char* label, const CounterValues& counts) const
+    {
+        std::cout << std::setw(22) << label;
+        for (unsigned int k = 0; k < counter_count; ++k)
+        {
+            std::cout << std::setw(15) << counts.values[k] / run_count;
+        }
+        std::cout << std::endl;
+    }
+};
+
+/// Prepares an nxn instance of the specified family before each run, and
+/// reports the hardware events counted during solves once the benchmark's
+/// last run is over.
+///
+/// The Munkres procedure is stepped manually so that events are attributed
+/// to the step that incurred them. Reading the counters between steps costs
+/// a system call each, so the run times of these benchmarks are slightly
+/// inflated compared to those in instance_families.cpp.
+template <Family family, unsigned int n, unsigned int runs>
+class CountedInstanceFixture : public ::hayai::Fixture
+{
+    public:
+    virtual void SetUp()
+    {
+        counters();
+
+        C_copy = instance(family, n);
+        C_copy_row_pointers.resize(n);
+        for (unsigned int i = 0; i < n; ++i)
+        {
+            C_copy_row_pointers[i] = &C_copy[i * n];
+        }
+        assignment.resize(n);
+    }
+
+    protected:
+    /// Solves the instance with the Munkres procedure, one step at a time.
+    void solve_with_munkres()
+    {
+        PerformanceCounters& counters = ::counters();
+        const CounterValues start = counters.read();
+
+        Problem problem(n, C_copy_row_pointers.data());
+        CounterValues before = start;
+        while (problem.next_step() != Problem::Step::Done)
+        {
+            const int s = static_cast<int>(problem.next_step());
+            problem.step();
+
+            const CounterValues after = counters.read();
+            munkres.steps[s] += after - before;
+            ++ munkres.step_invocations[s];
+            before = after;
+        }
+        problem.solve(assignment.data());
+
+        munkres.solve += counters.read() - start;
+        if (++ munkres.run_count == runs) { munkres.report_and_reset(); }
+    }
+    /// Solves the instance with the augmenting path engine.
+    void solve_with_augmenting_paths()
+    {
+        PerformanceCounters& counters = ::counters();
+        const CounterValues start = counters.read();
+
+        const unsigned int* const costs = C_copy.data();
+        solve_for_minimum_cost_assignment_lazily(
+            n,
+            [costs](const unsigned int i, const unsigned int j)
+            {
+                return costs[static_cast<std::size_t>(i) * n + j];
+            },
+            /* cached_row_count: */ 0,
+            assignment.data()
+        );
+
+        augmenting_path.solve += counters.read() - start;
+        if (++ augmenting_path.run_count == runs)
+        {
+            augmenting_path.report_and_reset();
+        }
+    }
+
+    private:
+    // A new fixture is constructed for each run, so tallies are static.
+    static Tally munkres;
+    static Tally augmenting_path;
+
+    std::vector<unsigned int>  C_copy;
+    std::vector<unsigned int*> C_copy_row_pointers;
+    std::vector<unsigned int>  assignment;
+};
+template <Family family, unsigned int n, unsigned int runs>
+Tally CountedInstanceFixture<family, n, runs>::munkres;
+template <Family family, unsigned int n, unsigned int runs>
+Tally CountedInstanceFixture<family, n, runs>::augmenting_path;
+
+/// Declares benchmarks counting events of both engines for an instance
+/// family and size.
+#define BENCHMARK_COUNTED(family, n, runs)                                \
+    typedef CountedInstanceFixture<Family::family, n, runs>               \
+            Counters_ ## family ## _n_ ## n;                              \
+    BENCHMARK_F(Counters_ ## family ## _n_ ## n, Munkres,         runs, 1) \
+    {                                                                     \
+        solve_with_munkres();                                             \
+    }                                                                     \
+    BENCHMARK_F(Counters_ ## family ## _n_ ## n, Augmenting_Path, runs, 1) \
+    {                                                                     \
+        solve_with_augmenting_paths();                                    \
+    }
+
+BENCHMARK_COUNTED(Uniform,     100, 10)
+BENCHMARK_COUNTED(Uniform,     300,  3)
+BENCHMARK_COUNTED(Geometric,   100, 10)
+BENCHMARK_COUNTED(Geometric,   300,  3)
+BENCHMARK_COUNTED(Sparse,      300,  3)
+BENCHMARK_COUNTED(Degenerate,  300,  3)
+BENCHMARK_COUNTED(Adversarial, 100,  3)
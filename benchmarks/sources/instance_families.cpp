@@ -0,0 +1,117 @@
+#include <vector>
+
+#include <hayai/hayai.hpp>
+
+#include <hungarian_algorithm.h>
+
+#include "instances.h"
+
+
+using rharel::hungarian_algorithm::solve_for_minimum_cost_assignment;
+using rharel::hungarian_algorithm::solve_for_minimum_cost_assignment_lazily;
+
+
+/// The largest size the Munkres procedure is benchmarked at.
+constexpr unsigned int maximum_munkres_size = 500;
+
+/// Prepares an nxn instance of the specified family before each run.
+///
+/// The Munkres procedure overwrites its cost matrix, so it solves a fresh 
+/// copy made outside the timed region. The augmenting path engine only reads
+/// costs, so it solves the shared instance directly.
+template <Family family, unsigned int n>
+class InstanceFixture : public ::hayai::Fixture
+{
+    public:
+    virtual void SetUp()
+    {
+        C = &instance(family, n);
+        if constexpr (n <= maximum_munkres_size)
+        {
+            C_copy = *C;
+            C_copy_row_pointers.resize(n);
+            for (unsigned int i = 0; i < n; ++i)
+            {
+                C_copy_row_pointers[i] = &C_copy[i * n];
+            }
+        }
+        assignment.resize(n);
+    }
+    virtual void TearDown()
+    {
+        C_copy.clear();
+        C_copy.shrink_to_fit();
+    }
+
+    protected:
+    /// Solves the instance with the Munkres procedure.
+    void solve_with_munkres()
+    {
+        solve_for_minimum_cost_assignment(n, C_copy_row_pointers.data(), 
+                                          assignment.data());
+    }
+    /// Solves the instance with the augmenting path engine.
+    void solve_with_augmenting_paths()
+    {
+        const unsigned int* const costs = C->data();
+        solve_for_minimum_cost_assignment_lazily(
+            n, 
+            [costs](const unsigned int i, const unsigned int j) 
+            { 
+                return costs[static_cast<std::size_t>(i) * n + j]; 
+            },
+            /* cached_row_count: */ 0,
+            assignment.data()
+        );
+    }
+
+    private:
+    const std::vector<unsigned int>* C = nullptr;
+    std::vector<unsigned int>        C_copy;
+    std::vector<unsigned int*>       C_copy_row_pointers;
+    std::vector<unsigned int>        assignment;
+};
+
+/// Declares the fixture for an instance family and size.
+#define INSTANCE_FIXTURE(family, n) \
+    typedef InstanceFixture<Family::family, n> family ## _n_ ## n;
+
+/// Declares benchmarks of both engines for an instance family and size.
+#define BENCHMARK_BOTH(family, n, runs)                              \
+    INSTANCE_FIXTURE(family, n)                                      \
+    BENCHMARK_F(family ## _n_ ## n, Munkres,         runs, 1)        \
+    {                                                                \
+        solve_with_munkres();                                        \
+    }                                                                \
+    BENCHMARK_F(family ## _n_ ## n, Augmenting_Path, runs, 1)        \
+    {                                                                \
+        solve_with_augmenting_paths();                               \
+    }
+/// Declares a benchmark of the augmenting path engine only, for sizes the
+/// Munkres procedure is too slow at.
+#define BENCHMARK_AUGMENTING_PATH(family, n, runs)                   \
+    INSTANCE_FIXTURE(family, n)                                      \
+    BENCHMARK_F(family ## _n_ ## n, Augmenting_Path, runs, 1)        \
+    {                                                                \
+        solve_with_augmenting_paths();                               \
+    }
+
+/// Declares the benchmarks of one instance family, from n = 5 to n = 10000.
+#define BENCHMARK_FAMILY(family)                                     \
+    BENCHMARK_BOTH(family,                5, 100)                    \
+    BENCHMARK_BOTH(family,               10, 100)                    \
+    BENCHMARK_BOTH(family,               50,  50)                    \
+    BENCHMARK_BOTH(family,              100,  20)                    \
+    BENCHMARK_BOTH(family,              500,   2)                    \
+    BENCHMARK_AUGMENTING_PATH(family,  1000,   5)                    \
+    BENCHMARK_AUGMENTING_PATH(family,  5000,   1)                    \
+    BENCHMARK_AUGMENTING_PATH(family, 10000,   1)
+
+BENCHMARK_FAMILY(Uniform)
+BENCHMARK_FAMILY(Clustered)
+BENCHMARK_FAMILY(Geometric)
+BENCHMARK_FAMILY(Sparse)
+BENCHMARK_FAMILY(Rectangular)
+BENCHMARK_FAMILY(Degenerate)
+BENCHMARK_FAMILY(Adversarial)
+BENCHMARK_FAMILY(Narrow)
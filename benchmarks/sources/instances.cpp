@@ -0,0 +1,152 @@
+#include <random>
+#include <utility>
+
+#include <metric_costs.h>
+
+#include "instances.h"
+
+
+using rharel::hungarian_algorithm::Metric;
+using rharel::hungarian_algorithm::compute_metric_cost_matrix;
+
+
+/// Computes quantized Euclidean distances between two point sets.
+std::vector<unsigned int> euclidean_costs(const unsigned int        n,
+                                          const std::vector<float>& workers,
+                                          const std::vector<float>& tasks)
+{
+    std::vector<unsigned int>  C(static_cast<std::size_t>(n) * n);
+    std::vector<unsigned int*> C_row_pointers(n);
+    for (unsigned int i = 0; i < n; ++i) 
+    { 
+        C_row_pointers[i] = &C[static_cast<std::size_t>(i) * n]; 
+    }
+    compute_metric_cost_matrix(Metric::Euclidean, n, /* dimension: */ 2,
+                               workers.data(), tasks.data(), 
+                               /* scale: */ 10000.0f, C_row_pointers.data());
+    return C;
+}
+
+std::vector<unsigned int> generate_instance(const Family       family, 
+                                            const unsigned int n)
+{
+    std::mt19937 random(static_cast<unsigned int>(family) * 100003u + n);
+    std::vector<unsigned int> C(static_cast<std::size_t>(n) * n);
+
+    switch (family)
+    {
+        case Family::Uniform:
+        {
+            std::uniform_int_distribution<unsigned int> random_cost(0, 999);
+            for (auto& cost : C) { cost = random_cost(random); }
+            break;
+        }
+        case Family::Clustered:
+        {
+            const unsigned int cluster_count = 10;
+            std::uniform_real_distribution<float> random_center(0.0f, 1.0f);
+            std::normal_distribution<float>       random_offset(0.0f, 0.02f);
+            std::uniform_int_distribution<unsigned int> 
+                random_cluster(0, cluster_count - 1);
+
+            std::vector<float> centers(2 * cluster_count);
+            for (float& x : centers) { x = random_center(random); }
+
+            // Points are structure-of-arrays: all x coordinates, then all y.
+            std::vector<float> workers(2 * n), tasks(2 * n);
+            for (auto* points : { &workers, &tasks })
+            {
+                for (unsigned int i = 0; i < n; ++i)
+                {
+                    const unsigned int c = random_cluster(random);
+                    (*points)[i]     = centers[2 * c]     + random_offset(random);
+                    (*points)[n + i] = centers[2 * c + 1] + random_offset(random);
+                }
+            }
+            C = euclidean_costs(n, workers, tasks);
+            break;
+        }
+        case Family::Geometric:
+        {
+            std::uniform_real_distribution<float> random_coordinate(0.0f, 1.0f);
+            std::vector<float> workers(2 * n), tasks(2 * n);
+            for (float& x : workers) { x = random_coordinate(random); }
+            for (float& x : tasks)   { x = random_coordinate(random); }
+            C = euclidean_costs(n, workers, tasks);
+            break;
+        }
+        case Family::Sparse:
+        {
+            const unsigned int candidate_count = 8;
+            std::uniform_int_distribution<unsigned int> random_cost(0, 99);
+            std::uniform_int_distribution<unsigned int> random_task(0, n - 1);
+            for (auto& cost : C) { cost = 1000000; }
+            for (unsigned int i = 0; i < n; ++i)
+            {
+                for (unsigned int k = 0; k < candidate_count; ++k)
+                {
+                    C[static_cast<std::size_t>(i) * n + random_task(random)] = 
+                        random_cost(random);
+                }
+            }
+            break;
+        }
+        case Family::Rectangular:
+        {
+            std::uniform_int_distribution<unsigned int> random_cost(0, 999);
+            for (unsigned int i = 0; i < n / 2; ++i)
+            {
+                for (unsigned int j = 0; j < n; ++j)
+                {
+                    C[static_cast<std::size_t>(i) * n + j] = random_cost(random);
+                }
+            }
+            break;
+        }
+        case Family::Degenerate:
+        {
+            std::uniform_int_distribution<unsigned int> random_cost(0, 2);
+            for (auto& cost : C) { cost = random_cost(random); }
+            break;
+        }
+        case Family::Narrow:
+        {
+            std::uniform_int_distribution<unsigned int> random_cost(0, 99);
+            for (auto& cost : C) { cost = random_cost(random); }
+            break;
+        }
+        case Family::Adversarial:
+        {
+            for (unsigned int i = 0; i < n; ++i)
+            {
+                for (unsigned int j = 0; j < n; ++j)
+                {
+                    C[static_cast<std::size_t>(i) * n + j] = (i + 1) * (j + 1);
+                }
+            }
+            break;
+        }
+    }
+    return C;
+}
+
+const std::vector<unsigned int>& instance(const Family       family, 
+                                          const unsigned int n)
+{
+    // Only the last instance is kept, since the largest ones take hundreds
+    // of megabytes each. Runs of a benchmark are consecutive, so they share
+    // it.
+    static std::pair<Family, unsigned int> last_key(Family::Uniform, 0);
+    static std::vector<unsigned int>       last_instance;
+
+    const std::pair<Family, unsigned int> key(family, n);
+    if (key != last_key || last_instance.size() != 
+                           static_cast<std::size_t>(n) * n)
+    {
+        last_instance.clear();
+        last_instance.shrink_to_fit();
+        last_instance = generate_instance(family, n);
+        last_key      = key;
+    }
+    return last_instance;
+}
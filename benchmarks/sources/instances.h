@@ -0,0 +1,37 @@
+#pragma once
+
+#include <vector>
+
+
+/// Enumerates the families of benchmark instances.
+enum class Family : int
+{
+    /// C(i, j) uniform in [0, 1000).
+    Uniform = 0,
+    /// Distances between points drawn around a few shared cluster centers.
+    Clustered,
+    /// Distances between points uniform in the unit square.
+    Geometric,
+    /// Each row has 8 cheap candidate tasks; all other costs are high.
+    Sparse,
+    /// n / 2 workers with uniform costs, padded with zero-cost dummy workers 
+    /// to a square matrix.
+    Rectangular,
+    /// C(i, j) uniform in {0, 1, 2}, so there are many optimal assignments.
+    Degenerate,
+    /// C(i, j) = (i + 1) * (j + 1), the worst case for the Munkres procedure.
+    Adversarial,
+    /// C(i, j) uniform in [0, 100), so reduced rows hold many zeros, and
+    /// where step 2 stars them matters.
+    Narrow
+};
+
+/// Generates an nxn instance of the specified family (row-major).
+///
+/// Instances are deterministic: the same family and size always yield the 
+/// same costs.
+std::vector<unsigned int> generate_instance(Family family, unsigned int n);
+
+/// Returns an nxn instance of the specified family (row-major), generating it
+/// unless it was the last one requested.
+const std::vector<unsigned int>& instance(Family family, unsigned int n);
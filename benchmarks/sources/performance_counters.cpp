@@ -0,0 +1,147 @@
+#include "performance_counters.h"
+
+#ifdef __linux__
+    #include <cstring>
+
+    #include <linux/perf_event.h>
+    #include <sys/ioctl.h>
+    #include <sys/syscall.h>
+    #include <unistd.h>
+#endif
+
+
+CounterValues& CounterValues::operator+=(const CounterValues& other)
+{
+    for (unsigned int k = 0; k < counter_count; ++k)
+    {
+        values[k] += other.values[k];
+    }
+    return *this;
+}
+CounterValues CounterValues::operator-(const CounterValues& other) const
+{
+    CounterValues difference;
+    for (unsigned int k = 0; k < counter_count; ++k)
+    {
+        difference.values[k] = values[k] - other.values[k];
+    }
+    return difference;
+}
+
+#ifdef __linux__
+
+/// Opens a counter of the specified event, as a member of the specified
+/// group (or as a new group's leader if it is -1).
+/// Returns its file descriptor, or -1 on failure.
+int open_counter(const unsigned int  type,
+                 const unsigned long long config,
+                 const int           group)
+{
+    perf_event_attr attributes;
+    std::memset(&attributes, 0, sizeof(attributes));
+    attributes.size           = sizeof(attributes);
+    attributes.type           = type;
+    attributes.config         = config;
+    attributes.disabled       = group == -1 ? 1 : 0;  // Enabled with the group.
+    attributes.exclude_kernel = 1;
+    attributes.exclude_hv     = 1;
+    attributes.read_format    = PERF_FORMAT_GROUP;
+
+    return static_cast<int>(syscall(SYS_perf_event_open, &attributes,
+                                    /* pid: */ 0, /* cpu: */ -1,
+                                    group, /* flags: */ 0));
+}
+
+PerformanceCounters::PerformanceCounters()
+{
+    const struct { unsigned int type; unsigned long long config; }
+        events[counter_count] = {
+            { PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS },
+            { PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES   },
+            { PERF_TYPE_HW_CACHE,
+              PERF_COUNT_HW_CACHE_L1D |
+              (PERF_COUNT_HW_CACHE_OP_READ     << 8) |
+              (PERF_COUNT_HW_CACHE_RESULT_MISS << 16)        },
+            { PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES },
+            { PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES }
+        };
+
+    for (unsigned int k = 0; k < counter_count; ++k)
+    {
+        descriptors[k] = open_counter(events[k].type, events[k].config,
+                                      leader);
+        positions[k]   = -1;
+        if (descriptors[k] == -1) { continue; }
+
+        if (leader == -1) { leader = descriptors[k]; }
+        positions[k] = static_cast<int>(opened_count++);
+    }
+    if (leader != -1)
+    {
+        ioctl(leader, PERF_EVENT_IOC_RESET,  PERF_IOC_FLAG_GROUP);
+        ioctl(leader, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+    }
+}
+PerformanceCounters::~PerformanceCounters()
+{
+    for (unsigned int k = 0; k < counter_count; ++k)
+    {
+        if (descriptors[k] != -1) { close(descriptors[k]); }
+    }
+}
+CounterValues PerformanceCounters::read() const
+{
+    CounterValues counts;
+    if (leader == -1) { return counts; }
+
+    // Layout under PERF_FORMAT_GROUP: the number of counters, followed by
+    // the value of each in the order they were opened.
+    unsigned long long buffer[1 + counter_count];
+    if (::read(leader, buffer, sizeof(buffer)) <= 0) { return counts; }
+
+    for (unsigned int k = 0; k < counter_count; ++k)
+    {
+        if (positions[k] != -1) { counts.values[k] = buffer[1 + positions[k]]; }
+    }
+    return counts;
+}
+
+#else
+
+PerformanceCounters::PerformanceCounters()
+{
+    for (unsigned int k = 0; k < counter_count; ++k)
+    {
+        descriptors[k] = -1;
+        positions[k]   = -1;
+    }
+}
+PerformanceCounters::~PerformanceCounters() {}
+CounterValues PerformanceCounters::read() const
+{
+    return CounterValues();
+}
+
+#endif
+
+bool PerformanceCounters::is_available(const Counter counter) const
+{
+    return positions[static_cast<int>(counter)] != -1;
+}
+bool PerformanceCounters::is_any_available() const
+{
+    return opened_count > 0;
+}
+
+const char* name(const Counter counter)
+{
+    switch (counter)
+    {
+        case Counter::Instructions:         { return "instructions";  }
+        case Counter::Cycles:               { return "cycles";        }
+        case Counter::L1DataMisses:         { return "L1D misses";    }
+        case Counter::LastLevelCacheMisses: { return "LLC misses";    }
+        case Counter::BranchMisses:         { return "branch misses"; }
+    }
+    return "";
+}
@@ -0,0 +1,69 @@
+#pragma once
+
+
+/// Enumerates the hardware events counted by PerformanceCounters.
+enum class Counter : int
+{
+    Instructions = 0,
+    Cycles,
+    /// Level 1 data cache read misses.
+    L1DataMisses,
+    /// Last level cache misses.
+    LastLevelCacheMisses,
+    BranchMisses
+};
+/// The number of counters.
+constexpr unsigned int counter_count = 5;
+
+/// Holds a value for each counter.
+struct CounterValues
+{
+    unsigned long long values[counter_count] = {};
+
+    unsigned long long& operator[](const Counter counter)
+    {
+        return values[static_cast<int>(counter)];
+    }
+    unsigned long long operator[](const Counter counter) const
+    {
+        return values[static_cast<int>(counter)];
+    }
+
+    CounterValues& operator+=(const CounterValues& other);
+    CounterValues  operator-(const CounterValues& other) const;
+};
+
+/// Counts hardware events of the calling thread in user space.
+///
+/// On Linux, counters are opened through perf_event_open(2) as one group, so
+/// they are read together in a single system call. Events that the hardware
+/// or the system configuration (see /proc/sys/kernel/perf_event_paranoid)
+/// does not allow are left out and read as zero. On other platforms, no
+/// counter is available.
+class PerformanceCounters
+{
+    public:
+    /// Opens and starts the counters.
+    PerformanceCounters();
+    PerformanceCounters(const PerformanceCounters&)            = delete;
+    PerformanceCounters& operator=(const PerformanceCounters&) = delete;
+    ~PerformanceCounters();
+
+    /// Returns true iff the specified counter is being counted.
+    bool is_available(Counter counter) const;
+    /// Returns true iff any counter is being counted.
+    bool is_any_available() const;
+
+    /// Reads the counts since the counters were opened. Differences between
+    /// two reads attribute events to the code executed in between.
+    CounterValues read() const;
+
+    private:
+    int leader = -1;                    // File descriptor of the group.
+    int descriptors[counter_count];     // -1 for unavailable counters.
+    int positions[counter_count];       // Index of each counter in a read.
+    unsigned int opened_count = 0;
+};
+
+/// Returns the name of the specified counter, as used in reports.
+const char* name(Counter counter);
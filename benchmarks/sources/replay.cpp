@@ -0,0 +1,165 @@
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <hayai/hayai.hpp>
+
+#include <hungarian_algorithm.h>
+
+#include "instances.h"
+
+
+using rharel::hungarian_algorithm::solve_for_minimum_cost_assignment;
+using rharel::hungarian_algorithm::solve_for_minimum_cost_assignment_lazily;
+
+
+/// The environment variable naming a recorded size distribution.
+constexpr const char* sizes_variable = "HUNGARIAN_BENCHMARK_SIZES";
+
+/// Reads a size distribution: one line per problem size, holding the size
+/// and optionally the number of requests of that size (1 if omitted). Blank
+/// lines and lines starting with '#' are ignored.
+///
+/// Returns true iff the file was read and holds at least one request.
+bool read_size_distribution(const char* path, std::vector<unsigned int>& sizes)
+{
+    std::ifstream file(path);
+    if (!file) { return false; }
+
+    std::string line;
+    while (std::getline(file, line))
+    {
+        if (line.empty() || line[0] == '#') { continue; }
+
+        std::istringstream fields(line);
+        unsigned int size, count = 1;
+        if (!(fields >> size)) { continue; }
+        fields >> count;
+        if (size == 0) { continue; }
+
+        sizes.insert(sizes.end(), count, size);
+    }
+    return !sizes.empty();
+}
+/// Returns the sizes of the requests to replay, in the order they are
+/// replayed.
+///
+/// They are read from the file named by HUNGARIAN_BENCHMARK_SIZES if it is
+/// set. Otherwise, a small illustrative distribution skewed towards small
+/// problems is used. Either way, requests are shuffled with a fixed seed so
+/// that sizes are interleaved the same way on every run.
+const std::vector<unsigned int>& replayed_sizes()
+{
+    static const std::vector<unsigned int> sizes = []()
+    {
+        std::vector<unsigned int> sizes;
+
+        const char* const path = std::getenv(sizes_variable);
+        if (path != nullptr && !read_size_distribution(path, sizes))
+        {
+            std::cerr << "Cannot read a size distribution from '" << path
+                      << "'; using the default one." << std::endl;
+            sizes.clear();
+        }
+        if (sizes.empty())
+        {
+            const unsigned int default_distribution[][2] = {
+                // Size, count.
+                {   5, 400 }, {  10, 300 }, {  20, 150 },
+                {  50,  80 }, { 100,  50 }, { 200,  20 }
+            };
+            for (const auto& entry : default_distribution)
+            {
+                sizes.insert(sizes.end(), entry[1], entry[0]);
+            }
+        }
+        std::shuffle(sizes.begin(), sizes.end(), std::mt19937(2018));
+        return sizes;
+    }();
+    return sizes;
+}
+
+/// Prepares the next replayed request before each run, so that every run
+/// times exactly one solve and run time percentiles are request latency
+/// percentiles.
+///
+/// Instances are uniform random and are generated once per distinct size.
+class Replay : public ::hayai::Fixture
+{
+    public:
+    virtual void SetUp()
+    {
+        const std::vector<unsigned int>& sizes = replayed_sizes();
+        n = sizes[next_request++ % sizes.size()];
+
+        auto cached = instances.find(n);
+        if (cached == instances.end())
+        {
+            cached = instances.emplace(
+                n, generate_instance(Family::Uniform, n)
+            ).first;
+        }
+        C = &cached->second;
+
+        C_copy = *C;
+        C_copy_row_pointers.resize(n);
+        for (unsigned int i = 0; i < n; ++i)
+        {
+            C_copy_row_pointers[i] = &C_copy[i * n];
+        }
+        assignment.resize(n);
+    }
+
+    protected:
+    /// Solves the current request with the Munkres procedure.
+    void solve_with_munkres()
+    {
+        solve_for_minimum_cost_assignment(n, C_copy_row_pointers.data(),
+                                          assignment.data());
+    }
+    /// Solves the current request with the augmenting path engine.
+    void solve_with_augmenting_paths()
+    {
+        const unsigned int* const costs = C->data();
+        const unsigned int        size  = n;
+        solve_for_minimum_cost_assignment_lazily(
+            n,
+            [costs, size](const unsigned int i, const unsigned int j)
+            {
+                return costs[static_cast<std::size_t>(i) * size + j];
+            },
+            /* cached_row_count: */ 0,
+            assignment.data()
+        );
+    }
+
+    private:
+    // A new fixture is constructed for each run, so state that spans runs is
+    // static. Each benchmark runs once per request, so each one replays the
+    // sequence from the start.
+    static std::map<unsigned int, std::vector<unsigned int>> instances;
+    static std::size_t next_request;
+
+    unsigned int                     n = 0;
+    const std::vector<unsigned int>* C = nullptr;
+    std::vector<unsigned int>        C_copy;
+    std::vector<unsigned int*>       C_copy_row_pointers;
+    std::vector<unsigned int>        assignment;
+};
+std::map<unsigned int, std::vector<unsigned int>> Replay::instances;
+std::size_t Replay::next_request = 0;
+
+BENCHMARK_F(Replay, Munkres, replayed_sizes().size(), 1)
+{
+    solve_with_munkres();
+}
+BENCHMARK_F(Replay, Augmenting_Path, replayed_sizes().size(), 1)
+{
+    solve_with_augmenting_paths();
+}
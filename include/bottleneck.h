@@ -0,0 +1,84 @@
+#pragma once
+
+
+/// Contains methods for solving the linear bottleneck assignment problem:
+/// given n workers, n tasks, and the cost matrix C, find an assignment of
+/// workers to tasks whose maximum cost, rather than total cost, is minimal.
+namespace rharel::hungarian_algorithm
+{
+    /// Solves the bottleneck assignment problem from a given cost matrix.
+    ///
+    /// Searches the distinct costs for the least threshold t such that the
+    /// bipartite graph of pairs with C(i, j) <= t has a perfect matching,
+    /// finding maximum matchings by the Hopcroft-Karp algorithm. The search
+    /// starts from the largest row or column minimum, which no assignment
+    /// can beat, and each matching is extended from the one of the largest
+    /// threshold found too low, since its pairs remain edges at any larger
+    /// threshold. Takes O(n^2.5 log n) time.
+    ///
+    /// @param problem_size
+    ///     The number of workers/tasks.
+    /// @param cost_matrix
+    ///     A square matrix with problem_size rows and columns. Member (i, j)
+    ///     represents the cost of assigning worker i to task j.
+    /// @param[out] assignment
+    ///     An output buffer for the minimum bottleneck assignment.
+    ///
+    /// Returns the maximum cost of the assignment.
+    unsigned int solve_for_bottleneck_assignment(unsigned int   problem_size,
+                                                 unsigned int** cost_matrix,
+                                                 unsigned int*  assignment);
+
+    /// Builds the cost matrix and solves the bottleneck assignment problem.
+    ///
+    /// @tparam CostComputer
+    ///     The type of a function-like object:
+    ///     unsigned int (*)(unsigned int i, unsigned int j);
+    ///
+    /// @param problem_size
+    ///     The number of workers/tasks.
+    /// @param compute_cost
+    ///     Computes the cost of assigning worker i to task j.
+    /// @param[out] assignment
+    ///     An output buffer for the minimum bottleneck assignment.
+    ///
+    /// Returns the maximum cost of the assignment.
+    template <typename CostComputer>
+    unsigned int solve_for_bottleneck_assignment(
+        unsigned int        problem_size,
+        const CostComputer& compute_cost,
+        unsigned int*       assignment);
+
+    /// Builds the cost matrix and solves the bottleneck assignment problem.
+    ///
+    /// @tparam Worker
+    ///     The worker type.
+    /// @tparam Task
+    ///     The task type.
+    /// @tparam CostComputer
+    ///     The type of a function-like object:
+    ///     unsigned int (*)(unsigned int i, unsigned int j,
+    ///                      const Worker& worker, const Task& task);
+    ///
+    /// @param problem_size
+    ///     The number of workers/tasks.
+    /// @param workers
+    ///     A list of workers.
+    /// @param tasks
+    ///     A list of tasks.
+    /// @param compute_cost
+    ///     Computes the cost of assigning worker i to task j.
+    /// @param[out] assignment
+    ///     An output buffer for the minimum bottleneck assignment.
+    ///
+    /// Returns the maximum cost of the assignment.
+    template <class Worker, class Task, typename CostComputer>
+    unsigned int solve_for_bottleneck_assignment(
+        unsigned int        problem_size,
+        const Worker*       workers,
+        const Task*         tasks,
+        const CostComputer& compute_cost,
+        unsigned int*       assignment);
+}
+
+#include "bottleneck.hpp"
@@ -0,0 +1,47 @@
+#include <vector>
+
+#include "bottleneck.h"
+#include "hungarian_algorithm.h"
+
+
+namespace rharel::hungarian_algorithm
+{
+    template <typename CostComputer>
+    unsigned int solve_for_bottleneck_assignment(
+        /* problem size:  */ const unsigned int  n,
+        /* cost function: */ const CostComputer& c,
+        /* assignment:    */ unsigned int*       A)
+    {
+        using std::vector;
+        using detail::compute_cost_matrix;
+
+        vector<vector<unsigned int>> C(n);
+        vector<unsigned int*>        C_row_pointers(n);
+        for (unsigned int i = 0; i < n; ++i)
+        {
+            C[i].resize(n);
+            C_row_pointers[i] = C[i].data();
+        }
+        unsigned int** C_raw = C_row_pointers.data();
+        compute_cost_matrix(n, c, C_raw);
+        return solve_for_bottleneck_assignment(n, C_raw, A);
+    }
+    template <class Worker, class Task, typename CostComputer>
+    unsigned int solve_for_bottleneck_assignment(
+        /* problem size:  */ const unsigned int  n,
+        /* workers:       */ const Worker*       W,
+        /* tasks:         */ const Task*         T,
+        /* cost function: */ const CostComputer& c,
+        /* assignment:    */ unsigned int*       A)
+    {
+        return solve_for_bottleneck_assignment(
+            /* problem_size:  */ n,
+            /* cost function: */ [&c, &W, &T] (const unsigned int i,
+                                               const unsigned int j)
+                                 {
+                                    return c(i, j, W[i], T[j]);
+                                 },
+            /* assignment:    */ A
+        );
+    }
+}
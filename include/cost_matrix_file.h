@@ -0,0 +1,298 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <istream>
+#include <ostream>
+#include <vector>
+
+
+/// Contains reading and writing of cost matrices in a binary file format.
+///
+/// # Layout
+/// A file (or stream) is a sequence of one or more records, each holding one
+/// cost matrix. All fields are little-endian. A record starts with a 64-byte
+/// header:
+///
+/// | Offset | Type      | Field                                            |
+/// | ------ | --------- | ------------------------------------------------ |
+/// |      0 | char[8]   | Magic: "HUNGCOST".                               |
+/// |      8 | uint32    | Format version: 1.                               |
+/// |     12 | uint32    | Cost encoding (see CostEncoding).                |
+/// |     16 | uint32    | n: the number of rows and columns.               |
+/// |     20 | uint32    | Stride: the number of costs per stored row, >= n.|
+/// |     24 | uint64    | Payload size in bytes.                           |
+/// |     32 | uint8[32] | Reserved, zero.                                  |
+///
+/// The payload follows the header and is zero-padded to a multiple of 64
+/// bytes, after which the next record (if any) begins.
+///
+/// With a fixed-width encoding, row i starts at byte offset i * stride *
+/// width of the payload, where width is the byte size of one cost. The
+/// writer pads rows to a multiple of 64 bytes so every row starts on a cache
+/// line once the file is mapped at a page boundary.
+///
+/// With a variable-width encoding, the stride equals n and the payload holds
+/// n^2 LEB128 varints in row-major order. Under CostEncoding::Varint each
+/// is a cost. Under CostEncoding::DeltaVarint the first varint of a row is
+/// its first cost, and each subsequent one is the zigzag-encoded difference
+/// between a cost and its predecessor in the row.
+namespace rharel::hungarian_algorithm
+{
+    /// Enumerates the encodings of costs in the payload of a cost matrix
+    /// record. The value of each fixed-width encoding is its byte size.
+    enum class CostEncoding : std::uint32_t
+    {
+        UInt8  = 1,
+        UInt16 = 2,
+        UInt32 = 4,
+
+        Varint      = 16,
+        DeltaVarint = 17
+    };
+
+    /// Enumerates hints about how a mapped cost matrix will be accessed.
+    enum class AccessAdvice : int
+    {
+        /// No particular pattern.
+        Normal = 0,
+        /// Rows are read in order; pages may be read ahead aggressively and
+        /// freed soon after they are read.
+        Sequential,
+        /// Rows are read in no particular order; read-ahead is wasteful.
+        Random,
+        /// The rows will be needed soon; they may be paged in ahead of time.
+        WillNeed
+    };
+
+    /// The byte size of a cost matrix record header.
+    constexpr unsigned int cost_matrix_header_size = 64;
+
+    /// A read-only view of a cost matrix stored with a fixed-width encoding.
+    ///
+    /// Does not own the costs it refers to.
+    class CostMatrixView
+    {
+        public:
+        CostMatrixView() = default;
+        /// Creates a new view of the specified payload.
+        CostMatrixView(unsigned int         problem_size,
+                       unsigned int         stride,
+                       CostEncoding         encoding,
+                       const unsigned char* payload)
+            : n(problem_size), row_stride(stride), cost_encoding(encoding),
+              data(payload)
+        {}
+
+        /// Returns the number of rows and columns.
+        unsigned int size() const { return n; }
+        /// Returns the number of costs per stored row.
+        unsigned int stride() const { return row_stride; }
+        /// Returns the encoding of costs.
+        CostEncoding encoding() const { return cost_encoding; }
+        /// Returns the start of the payload.
+        const unsigned char* payload() const { return data; }
+
+        /// Reads C(i, j).
+        unsigned int operator()(unsigned int i, unsigned int j) const;
+
+        private:
+        unsigned int         n          = 0;  // Problem size.
+        unsigned int         row_stride = 0;
+        CostEncoding         cost_encoding = CostEncoding::UInt32;
+        const unsigned char* data       = nullptr;
+    };
+
+    /// Writes cost matrix records to a stream.
+    class CostMatrixWriter
+    {
+        public:
+        /// Creates a new writer appending to the specified binary stream.
+        explicit CostMatrixWriter(std::ostream& stream);
+
+        /// Writes a cost matrix record.
+        ///
+        /// Returns true iff the record was written. Fails, writing nothing,
+        /// if a cost does not fit the specified encoding.
+        ///
+        /// @param problem_size
+        ///     The number of workers/tasks.
+        /// @param cost_matrix
+        ///     A square matrix with problem_size rows and columns.
+        /// @param encoding
+        ///     The encoding of costs in the record.
+        bool write(unsigned int                     problem_size,
+                   const unsigned int* const* const cost_matrix,
+                   CostEncoding                     encoding
+                       = CostEncoding::UInt32);
+
+        private:
+        std::ostream& stream;
+        std::vector<unsigned char> payload;  // Reused between records.
+    };
+
+    /// Reads cost matrix records from an in-memory buffer.
+    ///
+    /// Fixed-width records are not copied: views refer straight into the
+    /// buffer, which must outlive them. Variable-width records are decoded
+    /// into storage owned by the reader.
+    class CostMatrixReader
+    {
+        public:
+        /// Creates a new reader over the specified buffer.
+        CostMatrixReader(const unsigned char* buffer, std::size_t size);
+
+        /// Reads the next record.
+        ///
+        /// Returns true iff one was read. The view remains valid until the
+        /// next call. Returns false at the end of the buffer, or if the
+        /// record is invalid, in which case failed() reports true.
+        bool next(CostMatrixView& view);
+        /// Returns true iff an invalid record was encountered.
+        bool failed() const { return has_failed; }
+
+        private:
+        const unsigned char* buffer;
+        std::size_t          size;
+        std::size_t          offset     = 0;
+        bool                 has_failed = false;
+
+        std::vector<unsigned int> decoded;  // Reused between records.
+    };
+
+    /// Reads cost matrix records from a stream, one at a time.
+    ///
+    /// Each record is read into storage owned by the reader, so views remain
+    /// valid only until the next record is read.
+    class CostMatrixStreamReader
+    {
+        public:
+        /// Creates a new reader consuming the specified binary stream.
+        explicit CostMatrixStreamReader(std::istream& stream);
+
+        /// Reads the next record.
+        ///
+        /// Returns true iff one was read. The view remains valid until the
+        /// next call. Returns false at the end of the stream, or if the
+        /// record is invalid, in which case failed() reports true.
+        bool next(CostMatrixView& view);
+        /// Returns true iff an invalid record was encountered.
+        bool failed() const { return has_failed; }
+
+        private:
+        /// Reads a payload of the specified byte size onto the record.
+        /// Returns true iff all of it was read.
+        bool read_payload(std::uint64_t payload_size);
+
+        std::istream& stream;
+        bool          has_failed = false;
+
+        std::vector<unsigned char> record;   // Reused between records.
+        std::vector<unsigned int>  decoded;  // Reused between records.
+    };
+
+    /// Writes a cost matrix file holding a single record.
+    ///
+    /// Returns true iff the file was written. Fails if a cost does not fit
+    /// the specified encoding.
+    ///
+    /// @param path
+    ///     The path of the file to (over)write.
+    /// @param problem_size
+    ///     The number of workers/tasks.
+    /// @param cost_matrix
+    ///     A square matrix with problem_size rows and columns.
+    /// @param encoding
+    ///     The encoding of costs in the file.
+    bool write_cost_matrix_file(const char*                      path,
+                                unsigned int                     problem_size,
+                                const unsigned int* const* const cost_matrix,
+                                CostEncoding                     encoding
+                                    = CostEncoding::UInt32);
+
+    /// A read-only cost matrix backed by a memory-mapped cost matrix file.
+    ///
+    /// The matrix is the file's first record, which must have a fixed-width
+    /// encoding. Costs are read straight from the mapping and are paged in by
+    /// the operating system as they are accessed, so the matrix need not fit
+    /// in memory alongside the solver.
+    class MappedCostMatrix
+    {
+        public:
+        MappedCostMatrix() = default;
+        MappedCostMatrix(const MappedCostMatrix&)            = delete;
+        MappedCostMatrix& operator=(const MappedCostMatrix&) = delete;
+        ~MappedCostMatrix();
+
+        /// Maps the specified cost matrix file, closing the current one (if
+        /// any) first.
+        ///
+        /// Solvers revisit rows in the order their searches reach them, so
+        /// the default advice keeps pages cached once read. Sequential suits
+        /// a single pass over the rows only.
+        ///
+        /// Returns true iff the file was mapped. Fails if the file cannot be
+        /// opened or its header is invalid.
+        bool open(const char* path,
+                  AccessAdvice advice = AccessAdvice::Normal);
+        /// Unmaps the current file (if any).
+        void close();
+
+        /// Hints how the specified range of rows will be accessed. Has no
+        /// effect on platforms without such hints.
+        void advise(AccessAdvice advice,
+                    unsigned int first_row,
+                    unsigned int row_count) const;
+
+        /// Returns true iff a file is mapped.
+        bool is_open() const { return data != nullptr; }
+        /// Returns the number of rows and columns.
+        unsigned int size() const { return matrix.size(); }
+        /// Returns the number of costs per stored row.
+        unsigned int stride() const { return matrix.stride(); }
+        /// Returns the encoding of costs.
+        CostEncoding encoding() const { return matrix.encoding(); }
+        /// Returns a view of the mapped matrix.
+        const CostMatrixView& view() const { return matrix; }
+
+        /// Reads C(i, j).
+        unsigned int operator()(const unsigned int i,
+                                const unsigned int j) const
+        {
+            return matrix(i, j);
+        }
+
+        private:
+        const unsigned char* data = nullptr;  // The mapping.
+        std::uint64_t data_size   = 0;        // The mapping's size in bytes.
+        #ifdef _WIN32
+        void* file_handle    = nullptr;
+        void* mapping_handle = nullptr;
+        #endif
+
+        CostMatrixView matrix;
+    };
+
+    /// Solves the assignment problem for a fixed-width cost matrix view.
+    ///
+    /// The matrix is only read, one row at a time, and is not copied.
+    ///
+    /// @param cost_matrix
+    ///     A view of a square matrix. Member (i, j) represents the cost of
+    ///     assigning worker i to task j.
+    /// @param[out] assignment
+    ///     An output buffer for the minimum cost assignment.
+    void solve_for_minimum_cost_assignment(const CostMatrixView& cost_matrix,
+                                           unsigned int*         assignment);
+    /// Solves the assignment problem for a memory-mapped cost matrix.
+    ///
+    /// The matrix is only read, one row at a time, and is not copied.
+    ///
+    /// @param cost_matrix
+    ///     An open mapped cost matrix. Member (i, j) represents the cost of
+    ///     assigning worker i to task j.
+    /// @param[out] assignment
+    ///     An output buffer for the minimum cost assignment.
+    void solve_for_minimum_cost_assignment(const MappedCostMatrix& cost_matrix,
+                                           unsigned int*           assignment);
+}
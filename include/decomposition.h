@@ -0,0 +1,81 @@
+#pragma once
+
+#include <limits>
+#include <vector>
+
+
+/// Contains decomposition of assignment problems with forbidden pairs into
+/// independent parts.
+///
+/// A row or column with a single pair that is not forbidden must be assigned
+/// that pair, which may leave others with a single pair in turn. Likewise,
+/// rows confined to as many columns as there are of them must take all of
+/// those columns, so the pairs of other rows in them are in no assignment.
+/// Eliminating those pairs too splits the rows and columns left into
+/// components that no assignment avoiding the forbidden pairs crosses
+/// (the fine Dulmage-Mendelsohn decomposition). So each component is an
+/// independent assignment problem, and the optimal assignment is the union
+/// of theirs.
+namespace rharel::hungarian_algorithm
+{
+    /// Denotes the cost of a pair that must not be assigned.
+    constexpr unsigned int forbidden_cost =
+        std::numeric_limits<unsigned int>::max();
+
+    /// Assigns the pairs that any assignment avoiding forbidden pairs must
+    /// include, in O(n^2) time, ahead of any solver. The rows and columns
+    /// left select a square submatrix (see SubmatrixView). Its optimal
+    /// assignment, together with the forced pairs, is optimal for the whole
+    /// problem.
+    ///
+    /// @param problem_size
+    ///     The number of workers/tasks.
+    /// @param cost_matrix
+    ///     A square matrix with problem_size rows and columns. Member (i, j)
+    ///     represents the cost of assigning worker i to task j, or is
+    ///     forbidden_cost if worker i must not be assigned task j.
+    /// @param[out] assignment
+    ///     An output buffer that receives the forced pairs. Members of the
+    ///     residual rows are left untouched.
+    /// @param[out] residual_rows
+    ///     Receives the indices of the rows left, in increasing order.
+    /// @param[out] residual_columns
+    ///     Receives the indices of the columns left, in increasing order.
+    ///
+    /// Returns false iff a row or column is left with no allowed pairs, so
+    /// there is no assignment avoiding forbidden pairs.
+    bool assign_forced_pairs(unsigned int                     problem_size,
+                             const unsigned int* const* const cost_matrix,
+                             unsigned int*                    assignment,
+                             std::vector<unsigned int>&       residual_rows,
+                             std::vector<unsigned int>&       residual_columns);
+
+    /// Solves the assignment problem from a given cost matrix, by assigning
+    /// forced pairs (see assign_forced_pairs()), then splitting the rest
+    /// into components and solving each on its own.
+    ///
+    /// Forced pairs are found in O(n^2) time, and components in O(n^2.5),
+    /// by way of a maximum matching of the allowed pairs. Components are
+    /// solved through index views of the cost matrix, without copying it,
+    /// by successive shortest augmenting paths, largest first, on the
+    /// specified number of threads.
+    ///
+    /// @param problem_size
+    ///     The number of workers/tasks.
+    /// @param cost_matrix
+    ///     A square matrix with problem_size rows and columns. Member (i, j)
+    ///     represents the cost of assigning worker i to task j, or is
+    ///     forbidden_cost if worker i must not be assigned task j.
+    /// @param[out] assignment
+    ///     An output buffer for the minimum cost assignment.
+    /// @param thread_count
+    ///     The number of threads solving components.
+    ///
+    /// Returns true iff there is an assignment avoiding forbidden pairs.
+    /// Otherwise, the contents of assignment are unspecified.
+    bool solve_for_minimum_cost_assignment_by_components(
+        unsigned int                     problem_size,
+        const unsigned int* const* const cost_matrix,
+        unsigned int*                    assignment,
+        unsigned int                     thread_count = 1);
+}
@@ -0,0 +1,162 @@
+#pragma once
+
+#include <limits>
+#include <vector>
+
+
+/// Contains private implementation details.
+namespace rharel::hungarian_algorithm::detail
+{
+    /// Finds maximum matchings of bipartite graphs between n rows and n
+    /// columns, by the Hopcroft-Karp algorithm [1].
+    ///
+    /// Each phase finds the shortest augmenting paths by a breadth-first
+    /// search from the unmatched rows, then augments along a maximal set of
+    /// disjoint ones by depth-first search. There are O(sqrt(n)) phases, each
+    /// taking O(n^2) time over a dense graph.
+    ///
+    /// The matching is kept between calls to maximize(), so a matching of one
+    /// graph may be extended to a maximum matching of a supergraph of it.
+    ///
+    /// # References
+    /// 1. J. E. Hopcroft and R. M. Karp. An n^(5/2) algorithm for maximum
+    ///    matchings in bipartite graphs. SIAM Journal on Computing, 1973.
+    class HopcroftKarp
+    {
+        public:
+        static constexpr unsigned int none =
+            std::numeric_limits<unsigned int>::max();
+
+        /// Creates an empty matching between n rows and n columns.
+        explicit HopcroftKarp(const unsigned int n)
+            : n(n), column_of_row(n, none), row_of_column(n, none),
+              layer(n), next_column(n)
+        {}
+
+        /// Extends the matching to a maximum one. Every matched pair must be
+        /// an edge.
+        ///
+        /// @tparam EdgePredicate
+        ///     The type of a function-like object:
+        ///     bool (*)(unsigned int i, unsigned int j);
+        ///
+        /// Returns the number of matched pairs.
+        template <typename EdgePredicate>
+        unsigned int maximize(const EdgePredicate& is_edge)
+        {
+            while (find_layers(is_edge))
+            {
+                for (unsigned int i = 0; i < n; ++i) { next_column[i] = 0; }
+                for (unsigned int i = 0; i < n; ++i)
+                {
+                    if (column_of_row[i] == none && augment(is_edge, i))
+                    {
+                        ++ matched_count;
+                    }
+                }
+            }
+            return matched_count;
+        }
+
+        /// Matches row i to column j. Both must be unmatched.
+        void match(const unsigned int i, const unsigned int j)
+        {
+            column_of_row[i] = j;
+            row_of_column[j] = i;
+            ++ matched_count;
+        }
+
+        /// Gets the number of matched pairs.
+        unsigned int size() const { return matched_count; }
+        /// Gets the column matched to row i, or none.
+        unsigned int column(const unsigned int i) const
+        {
+            return column_of_row[i];
+        }
+        /// Gets the row matched to column j, or none.
+        unsigned int row(const unsigned int j) const
+        {
+            return row_of_column[j];
+        }
+
+        private:
+        static constexpr unsigned int unreached = none;
+
+        /// Layers rows by their distance from the unmatched rows, along
+        /// alternating paths, up to the nearest unmatched column.
+        /// Returns true iff an unmatched column is reachable.
+        template <typename EdgePredicate>
+        bool find_layers(const EdgePredicate& is_edge)
+        {
+            queue.clear();
+            for (unsigned int i = 0; i < n; ++i)
+            {
+                if (column_of_row[i] == none)
+                {
+                    layer[i] = 0;
+                    queue.push_back(i);
+                }
+                else { layer[i] = unreached; }
+            }
+            free_column_layer = unreached;
+            for (std::size_t k = 0; k < queue.size(); ++k)
+            {
+                const unsigned int i = queue[k];
+                if (layer[i] >= free_column_layer) { break; }
+
+                for (unsigned int j = 0; j < n; ++j)
+                {
+                    if (!is_edge(i, j)) { continue; }
+
+                    const unsigned int r = row_of_column[j];
+                    if (r == none) { free_column_layer = layer[i]; }
+                    else if (layer[r] == unreached)
+                    {
+                        layer[r] = layer[i] + 1;
+                        queue.push_back(r);
+                    }
+                }
+            }
+            return free_column_layer != unreached;
+        }
+        /// Searches for a shortest augmenting path from row i along the
+        /// layers, and flips it if found.
+        /// Returns true iff one was found.
+        template <typename EdgePredicate>
+        bool augment(const EdgePredicate& is_edge, const unsigned int i)
+        {
+            for (; next_column[i] < n; ++ next_column[i])
+            {
+                const unsigned int j = next_column[i];
+                if (!is_edge(i, j)) { continue; }
+
+                const unsigned int r = row_of_column[j];
+                const bool is_path_end =
+                    r == none ? layer[i] == free_column_layer
+                              : layer[r] == layer[i] + 1 &&
+                                augment(is_edge, r);
+                if (is_path_end)
+                {
+                    column_of_row[i] = j;
+                    row_of_column[j] = i;
+                    ++ next_column[i];
+                    return true;
+                }
+            }
+            layer[i] = unreached;  // Dead end for the rest of this phase.
+            return false;
+        }
+
+        unsigned int n;  // Number of rows/columns.
+
+        std::vector<unsigned int> column_of_row,
+                                  row_of_column;
+        unsigned int              matched_count = 0;
+
+        // Scratch space of a phase.
+        std::vector<unsigned int> layer;
+        std::vector<unsigned int> next_column;
+        std::vector<unsigned int> queue;
+        unsigned int              free_column_layer = unreached;
+    };
+}
@@ -1,9 +1,13 @@
 #pragma once
 
+#include <atomic>
+#include <chrono>
 #include <vector>
 
 #include <eigen/Sparse>
 
+#include "tracer.h"
+
 
 /// Contains methods for solving the assignment problem [1] using the Hungarian
 /// algorithm [2].
@@ -30,6 +34,104 @@ namespace rharel::hungarian_algorithm
                                            unsigned int** cost_matrix,
                                            unsigned int*  assignment);
 
+    /// Describes the work performed by the Munkres procedure (see Problem).
+    ///
+    /// Recording is compiled out unless the library is built with 
+    /// HUNGARIAN_ALGORITHM_STATISTICS defined. Otherwise, all members remain
+    /// zero.
+    struct Statistics
+    {
+        /// The number of times each step was performed, indexed by
+        /// Problem::Step.
+        unsigned long long step_count[7] = {};
+        /// The time spent performing each step in nanoseconds, indexed by
+        /// Problem::Step.
+        unsigned long long step_nanoseconds[7] = {};
+
+        /// The number of primed zeros starred by step 5, summed over all 
+        /// augmenting paths.
+        unsigned long long augmenting_path_length_sum = 0;
+        /// The number of primed zeros starred by the longest augmenting path.
+        unsigned int       augmenting_path_length_maximum = 0;
+
+        /// The number of times step 6 adjusted C by a nonzero value.
+        unsigned long long adjustment_count = 0;
+
+        /// The number of members of C examined while searching for zeros in 
+        /// steps 2 and 4.
+        unsigned long long scanned_member_count = 0;
+    };
+
+    /// Solves the assignment problem from a given cost matrix, and reports 
+    /// statistics of the solution process.
+    ///
+    /// @param problem_size
+    ///     The number of workers/tasks.
+    /// @param cost_matrix
+    ///     A square matrix with problem_size rows and columns. Member (i, j)
+    ///     represents the cost of assigning worker i to task j.
+    /// @param[out] assignment
+    ///     An output buffer for the minimum cost assignment.
+    /// @param[out] statistics
+    ///     Receives the statistics (see Statistics).
+    void solve_for_minimum_cost_assignment(unsigned int   problem_size,
+                                           unsigned int** cost_matrix,
+                                           unsigned int*  assignment,
+                                           Statistics&    statistics);
+
+    /// Solves the assignment problem from a given cost matrix, and reports 
+    /// its total cost and an optimal solution of the dual problem.
+    ///
+    /// The dual solution certifies optimality: C(i, j) - u(i) - v(j) >= 0 
+    /// for all i, j, with equality wherever worker i is assigned task j (see
+    /// verify()).
+    ///
+    /// @param problem_size
+    ///     The number of workers/tasks.
+    /// @param cost_matrix
+    ///     A square matrix with problem_size rows and columns. Member (i, j)
+    ///     represents the cost of assigning worker i to task j.
+    /// @param[out] assignment
+    ///     An output buffer for the minimum cost assignment.
+    /// @param[out] row_potentials
+    ///     If not null, an output buffer for the dual variables u of rows.
+    /// @param[out] column_potentials
+    ///     If not null, an output buffer for the dual variables v of columns.
+    ///
+    /// Returns the total cost of the assignment.
+    unsigned long long solve_for_minimum_cost_assignment(
+        unsigned int   problem_size,
+        unsigned int** cost_matrix,
+        unsigned int*  assignment,
+        long long*     row_potentials,
+        long long*     column_potentials);
+
+    /// Checks that an assignment is optimal, given row and column potentials
+    /// that certify it, in O(n^2) time.
+    ///
+    /// Returns true iff the assignment is a permutation, the potentials are 
+    /// dual feasible (C(i, j) - u(i) - v(j) >= 0 for all i, j), and 
+    /// complementary slackness holds (C(i, j) - u(i) - v(j) = 0 wherever 
+    /// worker i is assigned task j). Then the assignment's cost equals the 
+    /// sum of the potentials, a lower bound on the cost of any assignment.
+    ///
+    /// @param problem_size
+    ///     The number of workers/tasks.
+    /// @param cost_matrix
+    ///     A square matrix with problem_size rows and columns. Member (i, j)
+    ///     represents the cost of assigning worker i to task j.
+    /// @param assignment
+    ///     The assignment to check.
+    /// @param row_potentials
+    ///     The dual variables u of rows.
+    /// @param column_potentials
+    ///     The dual variables v of columns.
+    bool verify(unsigned int                     problem_size,
+                const unsigned int* const* const cost_matrix,
+                const unsigned int*              assignment,
+                const long long*                 row_potentials,
+                const long long*                 column_potentials);
+
     /// Builds the cost matrix and solves the assignment problem.
     ///
     /// @tparam CostComputer
@@ -75,6 +177,119 @@ namespace rharel::hungarian_algorithm
                                            const CostComputer& compute_cost,
                                            unsigned int*       assignment);
 
+    /// Solves the assignment problem without materializing the cost matrix.
+    ///
+    /// Costs are requested from compute_cost only when the solver needs them
+    /// and are kept in a least-recently-used cache of whole rows. Evicted
+    /// rows are recomputed on demand. The cache occupies at most
+    /// cached_row_count * problem_size costs. With cached_row_count = 0,
+    /// every cost is computed on each access.
+    ///
+    /// @tparam CostComputer
+    ///     The type of a function-like object:
+    ///     unsigned int (*)(unsigned int i, unsigned int j);
+    ///
+    /// @param problem_size
+    ///     The number of workers/tasks.
+    /// @param compute_cost
+    ///     Computes the cost of assigning worker i to task j.
+    /// @param cached_row_count
+    ///     The maximum number of cost matrix rows to keep in memory.
+    /// @param[out] assignment
+    ///     An output buffer for the minimum cost assignment.
+    /// @param tracer
+    ///     If not null, records a span for the solve and for each 
+    ///     augmentation.
+    template <typename CostComputer>
+    void solve_for_minimum_cost_assignment_lazily(
+        unsigned int        problem_size,
+        const CostComputer& compute_cost,
+        unsigned int        cached_row_count,
+        unsigned int*       assignment,
+        Tracer*             tracer = nullptr);
+    /// Solves the assignment problem without materializing the cost matrix,
+    /// as above, and reports an optimal solution of the dual problem, which
+    /// certifies the assignment (see verify()).
+    ///
+    /// @param[out] row_potentials
+    ///     An output buffer for the dual variables u of rows.
+    /// @param[out] column_potentials
+    ///     An output buffer for the dual variables v of columns.
+    template <typename CostComputer>
+    void solve_for_minimum_cost_assignment_lazily(
+        unsigned int        problem_size,
+        const CostComputer& compute_cost,
+        unsigned int        cached_row_count,
+        unsigned int*       assignment,
+        long long*          row_potentials,
+        long long*          column_potentials,
+        Tracer*             tracer = nullptr);
+
+    /// Finds a partial assignment and dual potentials by the initialization
+    /// procedures of Jonker and Volgenant (column reduction, reduction
+    /// transfer and augmenting row reduction), in O(n^2) time on typical
+    /// inputs. Both solvers above start from it; other solvers may too, by
+    /// assigning the remaining rows over the reduced costs
+    /// C(i, j) - u(i) - v(j).
+    ///
+    /// Costs are read one row at a time, so compute_cost may evaluate them
+    /// lazily.
+    ///
+    /// @tparam CostComputer
+    ///     The type of a function-like object:
+    ///     unsigned int (*)(unsigned int i, unsigned int j);
+    ///
+    /// @param problem_size
+    ///     The number of workers/tasks.
+    /// @param compute_cost
+    ///     Computes the cost of assigning worker i to task j.
+    /// @param[out] assignment
+    ///     An output buffer for the partial assignment, with problem_size
+    ///     for unassigned workers.
+    /// @param[out] row_potentials
+    ///     An output buffer for the dual variables u of rows.
+    /// @param[out] column_potentials
+    ///     An output buffer for the dual variables v of columns.
+    ///
+    /// Returns the number of assigned workers. The potentials satisfy
+    /// C(i, j) - u(i) - v(j) >= 0 for all i, j, with equality wherever
+    /// worker i is assigned task j.
+    template <typename CostComputer>
+    unsigned int find_partial_assignment(unsigned int        problem_size,
+                                         const CostComputer& compute_cost,
+                                         unsigned int*       assignment,
+                                         long long*          row_potentials,
+                                         long long*          column_potentials);
+
+    /// Enumerates the outcomes of a solve with a time budget or cancellation.
+    enum class SolveStatus : int
+    {
+        /// The assignment is optimal.
+        Optimal = 0,
+        /// The deadline passed first. The assignment is feasible but not
+        /// necessarily optimal.
+        DeadlineExpired,
+        /// The solve was cancelled first. The assignment is feasible but not
+        /// necessarily optimal.
+        Cancelled,
+        /// The assignment's cost is within the requested relative gap of the
+        /// optimum, but not necessarily optimal.
+        WithinTolerance
+    };
+
+    /// Signals a solve running on another thread to stop early.
+    class CancellationToken
+    {
+        public:
+        /// Requests cancellation. Safe to invoke from any thread.
+        void cancel() { is_cancellation_requested.store(true); }
+        /// Returns true iff cancellation was requested.
+        bool is_cancelled() const { return is_cancellation_requested.load(); }
+
+        private:
+        std::atomic<bool> is_cancellation_requested{ false };
+    };
+
     /// Represents an assignment problem instance.
     class Problem
     {
@@ -98,8 +313,57 @@ namespace rharel::hungarian_algorithm
         /// Solves the problem and writes the solution onto the specified 
         /// output buffer.
         void solve(unsigned int* assignment);
+        /// Solves the problem unless the specified deadline passes first, and
+        /// writes the best assignment found onto the specified output buffer.
+        ///
+        /// The deadline is checked between steps. If it passes, the current 
+        /// starred zeros are completed greedily into a feasible assignment.
+        /// Invoking solve() again resumes from where this left off.
+        SolveStatus solve(unsigned int*                         assignment,
+                          std::chrono::steady_clock::time_point deadline);
+        /// Solves the problem unless the specified token is cancelled first,
+        /// and writes the best assignment found onto the specified output 
+        /// buffer.
+        ///
+        /// The token is checked between steps. If it is cancelled, the 
+        /// current starred zeros are completed greedily into a feasible 
+        /// assignment. Invoking solve() again resumes from where this left 
+        /// off.
+        SolveStatus solve(unsigned int*            assignment,
+                          const CancellationToken& token);
+        /// Solves the problem until the best assignment found is provably 
+        /// within the specified relative gap of the optimum, and writes it 
+        /// onto the specified output buffer.
+        ///
+        /// Bounds are checked after each augmentation. The procedure stops 
+        /// once (U - L) / U <= relative_gap_tolerance, where L is 
+        /// lower_bound() and U is the least upper_bound() seen so far. 
+        /// Invoking solve() again resumes from where this left off.
+        SolveStatus solve(unsigned int* assignment, 
+                          double        relative_gap_tolerance);
+
+        /// Returns a lower bound on the cost of an optimal assignment.
+        ///
+        /// That is, the sum of the row and column potentials (the amounts 
+        /// subtracted from rows and columns of C so far), a feasible solution
+        /// of the dual problem. It never decreases, and equals the optimal 
+        /// cost once the solution is ready.
+        unsigned long long lower_bound() const;
+        /// Returns an upper bound on the cost of an optimal assignment.
+        ///
+        /// That is, the cost of the current starred zeros completed greedily
+        /// into a feasible assignment (see solve() with a deadline). Takes 
+        /// O(n^2) time.
+        unsigned long long upper_bound() const;
+
+        /// Returns the row potentials u: the amounts subtracted from each row
+        /// of C so far. Once the solution is ready, they form an optimal dual
+        /// solution together with column_potentials() (see verify()).
+        const std::vector<long long>& row_potentials() const;
+        /// Returns the column potentials v: the amounts subtracted from each 
+        /// column of C so far.
+        const std::vector<long long>& column_potentials() const;
 
-        private:
         /// Enumerates steps of the algorithm.
         ///
         /// We use the 6-step procedure from [1] to arrive at a solution.
@@ -112,12 +376,27 @@ namespace rharel::hungarian_algorithm
             One, Two, Three, Four, Five, Six
         };
 
-        /// For each row in C, subtracts its members by the minimum amongst 
-        /// them. Proceeds to step 2.
+        /// Returns the step the next invocation of step() performs, or 
+        /// Step::Done if the solution is ready.
+        Step next_step() const;
+        /// Returns statistics of the steps performed so far (see 
+        /// Statistics).
+        const Statistics& statistics() const;
+        /// Records a span for each subsequent step on the specified tracer,
+        /// or stops recording if it is null. Spans of step 5 are 
+        /// augmentations.
+        void trace(Tracer* tracer);
+
+        private:
+        /// Subtracts the potentials found by the Jonker-Volgenant
+        /// initialization (see detail::initialize_by_reduction()) from C,
+        /// which leaves zeros on the partial assignment it finds. Proceeds
+        /// to step 2.
         Step step_1();
-        /// Finds an unstarred zero z = C(i, j), if there is no starred zero 
-        /// in either C(i, *) or C(*, j), star z. Repeats for each member of C.
-        /// Proceeds to step 3.
+        /// Stars a maximum set of zeros with no two in the same row or 
+        /// column, found by the Hopcroft-Karp algorithm from the partial 
+        /// assignment of step 1, so that step 5 is left with as few 
+        /// augmentations as possible. Proceeds to step 3.
         Step step_2();
         /// Covers all columns with a starred zero. If n columns were covered,
         /// we are done. Otherwise, proceeds to step 4.
@@ -139,11 +418,22 @@ namespace rharel::hungarian_algorithm
         /// Finds the smallest uncovered member m of C. Adds m to covered rows
         /// and subtracts it from uncovered columns. Proceeds to step 4.
         Step step_6();
+        /// Performs steps until done, the deadline passes or the token is 
+        /// cancelled, whichever comes first. Either may be null.
+        SolveStatus solve(
+            unsigned int*                                assignment,
+            const std::chrono::steady_clock::time_point* deadline,
+            const CancellationToken*                     token);
         /// Writes the current assignment to the specified buffer.
         void output_solution(unsigned int* assignment) const;
+        /// Writes a feasible assignment to the specified buffer: rows with a
+        /// starred zero are assigned its column, and each remaining row is 
+        /// assigned the cheapest column not assigned yet.
+        ///
+        /// Returns its cost with respect to the current (reduced) C.
+        unsigned long long output_greedy_completion(
+            unsigned int* assignment) const;
 
-        /// Finds the minimum member of C(i, *).
-        unsigned int minimum_in_row(unsigned int i) const;
         /// Finds the minimum uncovered member of C.
         /// If C does not contain uncovered members, returns the maximum 
         /// unsigned value instead.
@@ -184,9 +474,17 @@ namespace rharel::hungarian_algorithm
         std::vector<bool> is_covered_row, 
                           is_covered_column;
 
+        std::vector<unsigned int> reduced_assignment;  // Output of step 1.
         unsigned int uncovered_prime_zero[2];  // Output of step 4.
 
         Step current_step = Step::One;
+
+        std::vector<long long> u, v;            // Potentials.
+        unsigned long long dual_objective = 0;  // Sum of potentials.
+
+        // Recorded in const member functions too, hence mutable.
+        mutable Statistics recorded_statistics;
+        Tracer* tracer = nullptr;
     };
 }
 
@@ -1,3 +1,6 @@
+#include <algorithm>
+#include <limits>
+
 #include "hungarian_algorithm.h"
 
 
@@ -18,6 +21,356 @@ namespace rharel::hungarian_algorithm::detail
             }
         }
     }
+
+    /// Caches whole rows of a lazily evaluated cost matrix.
+    ///
+    /// At most capacity rows are held at once. When a row that is not cached
+    /// is requested, the least recently used row is evicted and the requested
+    /// one is computed in its place.
+    template <typename CostComputer>
+    class CostCache
+    {
+        public:
+        /// Creates a new cache over the nxn cost matrix computed by c.
+        CostCache(const unsigned int  n,
+                  const CostComputer& c,
+                  const unsigned int  capacity)
+            : n(n), c(c), capacity(capacity < n ? capacity : n),
+              costs(static_cast<std::size_t>(this->capacity) * n),
+              slot_of_row(n, none), row_of_slot(this->capacity, none),
+              previous_slot(this->capacity, none), 
+              next_slot(this->capacity, none)
+        {}
+
+        /// Looks up C(i, j), computing row i if it is not cached.
+        unsigned int operator()(const unsigned int i, 
+                                const unsigned int j) const
+        {
+            if (capacity == 0) { return static_cast<unsigned int>(c(i, j)); }
+            if (i != last_row) { last_row_costs = fetch(i); last_row = i; }
+            
+            return last_row_costs[j];
+        }
+
+        private:
+        /// Returns the cached row i, computing it if necessary.
+        const unsigned int* fetch(const unsigned int i) const
+        {
+            unsigned int slot = slot_of_row[i];
+            if (slot == none)
+            {
+                if (used_slot_count < capacity) { slot = used_slot_count++; }
+                else
+                {
+                    slot = least_recent;
+                    detach(slot);
+                    slot_of_row[row_of_slot[slot]] = none;
+                }
+                unsigned int* row = &costs[static_cast<std::size_t>(slot) * n];
+                for (unsigned int j = 0; j < n; ++j)
+                {
+                    row[j] = static_cast<unsigned int>(c(i, j));
+                }
+                slot_of_row[i]    = slot;
+                row_of_slot[slot] = i;
+            }
+            else { detach(slot); }
+            
+            attach_as_most_recent(slot);
+            return &costs[static_cast<std::size_t>(slot) * n];
+        }
+
+        /// Removes the specified slot from the recency list.
+        void detach(const unsigned int slot) const
+        {
+            const unsigned int previous = previous_slot[slot],
+                               next     = next_slot[slot];
+
+            if (previous != none) { next_slot[previous] = next; }
+            else                  { least_recent = next; }
+            if (next != none)     { previous_slot[next] = previous; }
+            else                  { most_recent = previous; }
+        }
+        /// Inserts the specified slot at the head of the recency list.
+        void attach_as_most_recent(const unsigned int slot) const
+        {
+            previous_slot[slot] = most_recent;
+            next_slot[slot]     = none;
+
+            if (most_recent != none) { next_slot[most_recent] = slot; }
+            else                     { least_recent = slot; }
+            most_recent = slot;
+        }
+
+        static constexpr unsigned int none = 
+            std::numeric_limits<unsigned int>::max();
+
+        const unsigned int  n;         // Problem size.
+        const CostComputer& c;         // Cost function.
+        const unsigned int  capacity;  // Maximum number of cached rows.
+
+        mutable std::vector<unsigned int> costs;  // Cached rows, per slot.
+        mutable std::vector<unsigned int> slot_of_row, 
+                                          row_of_slot;
+        mutable std::vector<unsigned int> previous_slot,  // Recency list,
+                                          next_slot;      // per slot.
+        mutable unsigned int used_slot_count = 0;
+        mutable unsigned int least_recent    = none,
+                             most_recent     = none;
+
+        mutable unsigned int        last_row       = none;
+        mutable const unsigned int* last_row_costs = nullptr;
+    };
+
+    /// Finds a partial assignment and dual potentials by the initialization
+    /// procedures of Jonker and Volgenant [1], in O(n^2) time on typical
+    /// inputs:
+    ///
+    /// 1. Column reduction: v(j) is the minimum of column j, and each row is
+    ///    assigned the last column whose minimum it holds, if any.
+    /// 2. Reduction transfer: a row assigned one column that way transfers
+    ///    the least reduced cost of its other columns from that column's
+    ///    potential to its own.
+    /// 3. Augmenting row reduction (two passes): each unassigned row takes
+    ///    the column of its least reduced cost, lowering that column's
+    ///    potential to the second least, and displaces the row holding it.
+    ///
+    /// On random dense inputs, few rows are left unassigned. Costs are read
+    /// one row at a time, so c may evaluate them lazily.
+    ///
+    /// Outputs column_of_row, with n for unassigned rows, and potentials u,
+    /// v such that c(i, j) - u(i) - v(j) >= 0 for all i, j, with equality
+    /// for assigned pairs.
+    ///
+    /// # References
+    /// 1. R. Jonker and A. Volgenant. A shortest augmenting path algorithm
+    ///    for dense and sparse linear assignment problems. Computing, 1987.
+    template <typename CostComputer>
+    void initialize_by_reduction(
+        /* problem size:  */ const unsigned int  n,
+        /* cost function: */ const CostComputer& c,
+        /* assignment:    */ unsigned int*       column_of_row,
+        /* potentials:    */ long long*          u,
+                             long long*          v)
+    {
+        using std::vector;
+
+        const long long    infinity = std::numeric_limits<long long>::max();
+        const unsigned int none     = n;
+
+        const auto cost = [&c](const unsigned int i, const unsigned int j)
+        {
+            return static_cast<long long>(c(i, j));
+        };
+
+        // Column reduction.
+        vector<unsigned int> row_of_minimum(n, 0);
+        for (unsigned int j = 0; j < n; ++j) { v[j] = infinity; }
+        for (unsigned int i = 0; i < n; ++i)
+        {
+            for (unsigned int j = 0; j < n; ++j)
+            {
+                const long long c_ij = cost(i, j);
+                if (c_ij < v[j]) { v[j] = c_ij; row_of_minimum[j] = i; }
+            }
+        }
+        vector<unsigned int> row_of_column(n, none),
+                             column_count(n, 0);
+        for (unsigned int i = 0; i < n; ++i) { column_of_row[i] = none; }
+        for (unsigned int j = n; j-- > 0;)
+        {
+            const unsigned int i = row_of_minimum[j];
+            if (column_count[i]++ == 0)
+            {
+                column_of_row[i] = j;
+                row_of_column[j] = i;
+            }
+        }
+
+        // Reduction transfer.
+        vector<unsigned int> free_rows;
+        for (unsigned int i = 0; i < n; ++i)
+        {
+            if (column_count[i] == 0) { free_rows.push_back(i); continue; }
+            if (column_count[i] > 1 || n == 1) { continue; }
+
+            const unsigned int j1      = column_of_row[i];
+            long long          minimum = infinity;
+            for (unsigned int j = 0; j < n; ++j)
+            {
+                if (j != j1) { minimum = std::min(minimum, cost(i, j) - v[j]); }
+            }
+            v[j1] -= minimum;
+        }
+
+        // Augmenting row reduction.
+        for (unsigned int pass = 0; pass < 2; ++pass)
+        {
+            const std::size_t free_row_count = free_rows.size();
+            std::size_t       k              = 0;
+            std::size_t       next_free_row_count = 0;
+            while (k < free_row_count)
+            {
+                const unsigned int i = free_rows[k++];
+
+                // The two least reduced costs of row i.
+                long long    least  = cost(i, 0) - v[0],
+                             second = infinity;
+                unsigned int j1 = 0, j2 = 0;
+                for (unsigned int j = 1; j < n; ++j)
+                {
+                    const long long h = cost(i, j) - v[j];
+                    if (h >= second) { continue; }
+                    if (h >= least) { second = h; j2 = j; }
+                    else
+                    {
+                        second = least; j2 = j1;
+                        least  = h;     j1 = j;
+                    }
+                }
+
+                unsigned int i0 = row_of_column[j1];
+                if (least < second) { v[j1] -= second - least; }
+                else if (i0 != none) { j1 = j2; i0 = row_of_column[j2]; }
+
+                if (i0 != none) { column_of_row[i0] = none; }
+                column_of_row[i]  = j1;
+                row_of_column[j1] = i;
+
+                if (i0 == none) { continue; }
+                // The displaced row is reassigned at once if its column's
+                // potential dropped, and on the next pass otherwise.
+                if (least < second) { free_rows[--k] = i0; }
+                else { free_rows[next_free_row_count++] = i0; }
+            }
+            free_rows.resize(next_free_row_count);
+        }
+
+        for (unsigned int i = 0; i < n; ++i)
+        {
+            u[i] = infinity;
+            for (unsigned int j = 0; j < n; ++j)
+            {
+                u[i] = std::min(u[i], cost(i, j) - v[j]);
+            }
+        }
+    }
+
+    /// Solves the assignment problem by successive shortest augmenting paths.
+    ///
+    /// Starts from the partial assignment and potentials of 
+    /// initialize_by_reduction(). The remaining rows are inserted one at a 
+    /// time. For each, a Dijkstra-like search over reduced costs finds the 
+    /// cheapest augmenting path, and the row and column potentials are 
+    /// updated so that reduced costs stay non-negative.
+    /// The search only reads costs, and reads them one row at a time, so c 
+    /// may evaluate them lazily.
+    ///
+    /// If a tracer is specified, records a span for each augmentation. If 
+    /// output buffers for potentials are specified, receives the final row 
+    /// and column potentials, which certify optimality (see verify()).
+    ///
+    /// # References
+    /// 1. R. Jonker and A. Volgenant. A shortest augmenting path algorithm
+    ///    for dense and sparse linear assignment problems. Computing, 1987.
+    template <typename CostComputer>
+    void solve_by_shortest_augmenting_paths(
+        /* problem size:  */ const unsigned int  n,
+        /* cost function: */ const CostComputer& c,
+        /* assignment:    */ unsigned int*       A,
+        /* tracer:        */ Tracer*             tracer = nullptr,
+        /* potentials:    */ long long*          u_out  = nullptr,
+                             long long*          v_out  = nullptr)
+    {
+        using std::vector;
+
+        const long long    infinity = std::numeric_limits<long long>::max();
+        const unsigned int none     = n;  // Also the index of a virtual column
+                                          // holding the row being inserted.
+        vector<long long>    u(n, 0),         // Row potentials.
+                             v(n + 1, 0);     // Column potentials.
+        vector<unsigned int> row_of_column(n + 1, none),
+                             previous_column(n + 1, none);
+        vector<long long>    minimum_slack(n + 1);
+        vector<bool>         is_visited_column(n + 1);
+
+        vector<unsigned int> column_of_row(n);
+        {
+            const TraceScope span(tracer, "initialization", 
+                                  "augmenting_path");
+            initialize_by_reduction(n, c, column_of_row.data(), 
+                                    u.data(), v.data());
+        }
+        for (unsigned int i = 0; i < n; ++i)
+        {
+            if (column_of_row[i] != none) 
+            { 
+                row_of_column[column_of_row[i]] = i; 
+            }
+        }
+
+        for (unsigned int i = 0; i < n; ++i)
+        {
+            if (column_of_row[i] != none) { continue; }
+
+            const TraceScope span(tracer, "augmentation", "augmenting_path");
+
+            std::fill(minimum_slack.begin(), minimum_slack.end(), infinity);
+            std::fill(is_visited_column.begin(), is_visited_column.end(), 
+                      false);
+
+            row_of_column[none] = i;
+            unsigned int j0 = none;
+            do
+            {
+                is_visited_column[j0] = true;
+
+                const unsigned int i0    = row_of_column[j0];
+                long long          delta = infinity;
+                unsigned int       j1    = none;
+                for (unsigned int j = 0; j < n; ++j)
+                {
+                    if (is_visited_column[j]) { continue; }
+
+                    const long long slack = 
+                        static_cast<long long>(c(i0, j)) - u[i0] - v[j];
+                    if (slack < minimum_slack[j])
+                    {
+                        minimum_slack[j]   = slack;
+                        previous_column[j] = j0;
+                    }
+                    if (minimum_slack[j] < delta)
+                    {
+                        delta = minimum_slack[j];
+                        j1    = j;
+                    }
+                }
+                for (unsigned int j = 0; j <= n; ++j)
+                {
+                    if (is_visited_column[j]) 
+                    { 
+                        u[row_of_column[j]] += delta; 
+                        v[j]                -= delta; 
+                    }
+                    else { minimum_slack[j] -= delta; }
+                }
+                j0 = j1;
+            } 
+            while (row_of_column[j0] != none);
+
+            // Flips the augmenting path ending at column j0.
+            while (j0 != none)
+            {
+                const unsigned int j1 = previous_column[j0];
+                row_of_column[j0] = row_of_column[j1];
+                j0 = j1;
+            }
+        }
+        for (unsigned int j = 0; j < n; ++j) { A[row_of_column[j]] = j; }
+
+        if (u_out != nullptr) { std::copy(u.begin(), u.end(),     u_out); }
+        if (v_out != nullptr) { std::copy(v.begin(), v.end() - 1, v_out); }
+    }
 }
 namespace rharel::hungarian_algorithm
 {
@@ -61,4 +414,60 @@ namespace rharel::hungarian_algorithm
             /* assignment:    */ A
         );
     }
+    template <typename CostComputer>
+    void solve_for_minimum_cost_assignment_lazily(
+        /* problem size:  */ const unsigned int  n,
+        /* cost function: */ const CostComputer& c,
+        /* cache size:    */ const unsigned int  cached_row_count,
+        /* assignment:    */ unsigned int*       A,
+        /* tracer:        */ Tracer*             tracer)
+    {
+        solve_for_minimum_cost_assignment_lazily(
+            n, c, cached_row_count, A,
+            /* potentials: */ nullptr, nullptr, tracer
+        );
+    }
+    template <typename CostComputer>
+    void solve_for_minimum_cost_assignment_lazily(
+        /* problem size:  */ const unsigned int  n,
+        /* cost function: */ const CostComputer& c,
+        /* cache size:    */ const unsigned int  cached_row_count,
+        /* assignment:    */ unsigned int*       A,
+        /* potentials:    */ long long*          u,
+                             long long*          v,
+        /* tracer:        */ Tracer*             tracer)
+    {
+        using detail::CostCache;
+        using detail::solve_by_shortest_augmenting_paths;
+
+        const TraceScope span(tracer, "solve", "augmenting_path");
+
+        if (n == 0) { return; }
+        if (n == 1)
+        {
+            A[0] = 0;
+            if (u != nullptr) { u[0] = c(0, 0); }
+            if (v != nullptr) { v[0] = 0; }
+            return;
+        }
+
+        const CostCache<CostComputer> cache(n, c, cached_row_count);
+        solve_by_shortest_augmenting_paths(n, cache, A, tracer, u, v);
+    }
+    template <typename CostComputer>
+    unsigned int find_partial_assignment(
+        /* problem size:  */ const unsigned int  n,
+        /* cost function: */ const CostComputer& c,
+        /* assignment:    */ unsigned int*       A,
+        /* potentials:    */ long long*          u,
+                             long long*          v)
+    {
+        if (n == 0) { return 0; }
+
+        detail::initialize_by_reduction(n, c, A, u, v);
+
+        return static_cast<unsigned int>(
+            n - std::count(A, A + n, n)
+        );
+    }
 }
@@ -0,0 +1,84 @@
+#pragma once
+
+#include <vector>
+
+
+/// Contains an implicit cost matrix for embedding similarity problems.
+///
+/// Here the cost of assigning worker i to task j is the negated inner product
+/// of their embeddings, C(i, j) = -<a_i, b_j>. Such a matrix has rank at most
+/// d, so it is stored as its two n x d factors rather than as n^2 costs.
+/// Embeddings are given row-major: coordinate k of embedding i is found at 
+/// embeddings[i * d + k].
+namespace rharel::hungarian_algorithm
+{
+    /// Evaluates the negated inner product cost on demand, quantized to 
+    /// non-negative integers.
+    ///
+    /// Since the solver requires non-negative costs, row i is offset by 
+    /// |a_i| * max_j |b_j|, which bounds <a_i, b_j> from above. Adding a 
+    /// constant to a row does not change which assignments are optimal. The
+    /// cost is then C(i, j) = round(scale * (|a_i| max_j |b_j| - <a_i, b_j>)).
+    ///
+    /// Holds O(n) memory of its own and refers to the embedding buffers, which
+    /// must outlive it.
+    class InnerProductCost
+    {
+        public:
+        /// Creates a new cost over the specified embeddings.
+        ///
+        /// @param problem_size
+        ///     The number of workers/tasks.
+        /// @param dimension
+        ///     The number of coordinates per embedding.
+        /// @param worker_embeddings
+        ///     Worker embeddings (row-major, problem_size x dimension).
+        /// @param task_embeddings
+        ///     Task embeddings (row-major, problem_size x dimension).
+        /// @param scale
+        ///     The factor costs are multiplied by before rounding.
+        InnerProductCost(unsigned int problem_size,
+                         unsigned int dimension,
+                         const float* worker_embeddings,
+                         const float* task_embeddings,
+                         float        scale);
+
+        /// Computes the cost of assigning worker i to task j.
+        unsigned int operator()(unsigned int i, unsigned int j) const;
+
+        private:
+        const unsigned int d;  // Dimension.
+        const float* A;        // Worker embeddings.
+        const float* B;        // Task embeddings.
+        const float  scale;    // Quantization factor.
+
+        std::vector<float> row_offsets;
+    };
+
+    /// Solves the assignment problem for the cost C(i, j) = -<a_i, b_j>,
+    /// that is, finds the assignment of maximum total inner product.
+    ///
+    /// The cost matrix is never materialized: costs are evaluated inside the
+    /// solver as they are needed, so memory use is O(n * d) for the 
+    /// embeddings plus O(n) for the solver.
+    ///
+    /// @param problem_size
+    ///     The number of workers/tasks.
+    /// @param dimension
+    ///     The number of coordinates per embedding.
+    /// @param worker_embeddings
+    ///     Worker embeddings (row-major, problem_size x dimension).
+    /// @param task_embeddings
+    ///     Task embeddings (row-major, problem_size x dimension).
+    /// @param scale
+    ///     The factor costs are multiplied by before rounding to integers.
+    /// @param[out] assignment
+    ///     An output buffer for the maximum inner product assignment.
+    void solve_for_maximum_inner_product_assignment(
+        unsigned int  problem_size,
+        unsigned int  dimension,
+        const float*  worker_embeddings,
+        const float*  task_embeddings,
+        float         scale,
+        unsigned int* assignment);
+}
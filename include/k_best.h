@@ -0,0 +1,51 @@
+#pragma once
+
+
+/// Contains ranking of assignments by cost.
+namespace rharel::hungarian_algorithm
+{
+    /// Finds the k least cost assignments, in order of increasing cost.
+    ///
+    /// Uses Murty's partitioning [1]: once the best assignment of a
+    /// subproblem is reported, the remaining assignments of that subproblem
+    /// are split into disjoint subproblems, each forbidding one of its pairs
+    /// and fixing the ones before it. A subproblem differs from its parent
+    /// by one forbidden pair, so it is solved from the parent's assignment
+    /// and dual potentials with a single augmentation, in O(n^2) time.
+    /// Subproblems are kept in a priority queue by a lower bound on their
+    /// cost, and are only solved once they reach its front, so most are
+    /// never solved at all.
+    ///
+    /// @param problem_size
+    ///     The number of workers/tasks.
+    /// @param cost_matrix
+    ///     A square matrix with problem_size rows and columns. Member (i, j)
+    ///     represents the cost of assigning worker i to task j.
+    /// @param k
+    ///     The number of assignments to find.
+    /// @param[out] assignments
+    ///     An output buffer for k assignments, each with problem_size
+    ///     members.
+    /// @param[out] costs
+    ///     If not null, an output buffer for the k assignments' costs.
+    /// @param thread_count
+    ///     The number of threads solving subproblems, started once per
+    ///     call. Whenever the front of the queue holds unsolved subproblems,
+    ///     up to this many of them are solved at once, each thread with its
+    ///     own O(n) workspace. Assignments are still found in order of
+    ///     increasing cost.
+    ///
+    /// Returns the number of assignments found, which is less than k only if
+    /// there are fewer than k distinct assignments.
+    ///
+    /// # References
+    /// 1. K. G. Murty. An algorithm for ranking all the assignments in order
+    ///    of increasing cost. Operations Research, 1968.
+    unsigned int solve_for_k_best_assignments(
+        unsigned int                     problem_size,
+        const unsigned int* const* const cost_matrix,
+        unsigned int                     k,
+        unsigned int**                   assignments,
+        unsigned long long*              costs,
+        unsigned int                     thread_count = 1);
+}
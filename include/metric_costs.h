@@ -0,0 +1,99 @@
+#pragma once
+
+
+/// Contains builders of cost matrices from distances between points.
+///
+/// Points are given as structure-of-arrays: for n points in d dimensions, 
+/// the buffer holds d consecutive arrays of n coordinates each, so that 
+/// coordinate k of point i is found at points[k * n + i].
+namespace rharel::hungarian_algorithm
+{
+    /// Enumerates the supported distance metrics.
+    enum class Metric : int
+    {
+        /// The L2 distance: sqrt(sum_k (w_k - t_k)^2).
+        Euclidean = 0,
+        /// The squared L2 distance: sum_k (w_k - t_k)^2.
+        SquaredEuclidean,
+        /// The L1 distance: sum_k |w_k - t_k|.
+        Manhattan,
+        /// The cosine distance: 1 - <w, t> / (|w| |t|). If either point is 
+        /// the origin, the distance is 1.
+        Cosine
+    };
+
+    /// Computes the distance between every worker and every task.
+    ///
+    /// @param metric
+    ///     The distance metric.
+    /// @param problem_size
+    ///     The number of workers/tasks.
+    /// @param dimension
+    ///     The number of coordinates per point.
+    /// @param workers
+    ///     Worker positions (structure-of-arrays, problem_size x dimension).
+    /// @param tasks
+    ///     Task positions (structure-of-arrays, problem_size x dimension).
+    /// @param[out] cost_matrix
+    ///     A square matrix with problem_size rows and columns. Member (i, j)
+    ///     receives the distance between worker i and task j.
+    void compute_metric_cost_matrix(Metric        metric,
+                                    unsigned int  problem_size,
+                                    unsigned int  dimension,
+                                    const float*  workers,
+                                    const float*  tasks,
+                                    float**       cost_matrix);
+
+    /// Computes the distance between every worker and every task, quantized
+    /// to integer costs.
+    ///
+    /// Member (i, j) receives round(scale * distance(i, j)), saturated at the
+    /// maximum unsigned value.
+    ///
+    /// @param metric
+    ///     The distance metric.
+    /// @param problem_size
+    ///     The number of workers/tasks.
+    /// @param dimension
+    ///     The number of coordinates per point.
+    /// @param workers
+    ///     Worker positions (structure-of-arrays, problem_size x dimension).
+    /// @param tasks
+    ///     Task positions (structure-of-arrays, problem_size x dimension).
+    /// @param scale
+    ///     The factor distances are multiplied by before rounding.
+    /// @param[out] cost_matrix
+    ///     A square matrix with problem_size rows and columns.
+    void compute_metric_cost_matrix(Metric         metric,
+                                    unsigned int   problem_size,
+                                    unsigned int   dimension,
+                                    const float*   workers,
+                                    const float*   tasks,
+                                    float          scale,
+                                    unsigned int** cost_matrix);
+
+    /// Solves the assignment problem where the cost of assigning worker i to
+    /// task j is their quantized distance, round(scale * distance(i, j)).
+    ///
+    /// @param metric
+    ///     The distance metric.
+    /// @param problem_size
+    ///     The number of workers/tasks.
+    /// @param dimension
+    ///     The number of coordinates per point.
+    /// @param workers
+    ///     Worker positions (structure-of-arrays, problem_size x dimension).
+    /// @param tasks
+    ///     Task positions (structure-of-arrays, problem_size x dimension).
+    /// @param scale
+    ///     The factor distances are multiplied by before rounding.
+    /// @param[out] assignment
+    ///     An output buffer for the minimum cost assignment.
+    void solve_for_minimum_metric_cost_assignment(Metric        metric,
+                                                  unsigned int  problem_size,
+                                                  unsigned int  dimension,
+                                                  const float*  workers,
+                                                  const float*  tasks,
+                                                  float         scale,
+                                                  unsigned int* assignment);
+}
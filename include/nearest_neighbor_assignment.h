@@ -0,0 +1,135 @@
+#pragma once
+
+#include "metric_costs.h"
+
+
+/// Contains solving of assignment problems between points without building
+/// the cost matrix.
+///
+/// In geometric instances, each worker is assigned one of its nearest tasks
+/// in all but a few cases. The problem is first solved over candidate pairs
+/// of each worker and its nearest tasks only. Then the dual potentials u, v
+/// of that solution show which pruned pairs (i, j) could improve it: only
+/// those with C(i, j) < u(i) + v(j). Those are added, and the affected rows
+/// are solved again, until there are none left. The result is then optimal
+/// for the full problem.
+///
+/// Instances of millions of points are solved in levels instead: workers and
+/// tasks are merged in pairs, level by level, the coarsest problem is solved,
+/// and each finer one starts from the assignment and potentials of the one
+/// above, so that its augmenting paths stay short. Lowering each u(i) to the
+/// least C(i, j) - v(j) over all tasks makes the potentials feasible for the
+/// full problem, so their sum bounds how far from optimal the result is, and
+/// pruned pairs are only added until that is close enough.
+namespace rharel::hungarian_algorithm
+{
+    /// Bounds the cost of an optimal assignment.
+    struct CostBounds
+    {
+        /// A lower bound: the dual objective of feasible potentials.
+        unsigned long long lower;
+        /// An upper bound: the cost of the assignment found.
+        unsigned long long upper;
+
+        /// Returns the relative gap (upper - lower) / upper, which the
+        /// assignment found is provably within of the optimum.
+        double relative_gap() const
+        {
+            return upper == 0 ? 0.0
+                              : static_cast<double>(upper - lower) / upper;
+        }
+    };
+
+    /// Solves the assignment problem where the cost of assigning worker i to
+    /// task j is their quantized distance, round(scale * distance(i, j)),
+    /// from candidate lists of each worker's nearest tasks.
+    ///
+    /// Candidates are each worker's candidate_count nearest tasks and each
+    /// task's candidate_count nearest workers, found with kd-trees. The
+    /// sparse problem is solved by successive shortest augmenting paths. A
+    /// worker whose candidates admit no augmenting path is given nearest
+    /// tasks beyond those its search reached. The assignment is optimal,
+    /// with the same total cost as that of
+    /// solve_for_minimum_metric_cost_assignment(), in O(n k) memory rather
+    /// than O(n^2).
+    ///
+    /// Cosine distances are not supported by the kd-tree, so for them this
+    /// solves the full problem instead.
+    ///
+    /// @param metric
+    ///     The distance metric.
+    /// @param problem_size
+    ///     The number of workers/tasks.
+    /// @param dimension
+    ///     The number of coordinates per point.
+    /// @param workers
+    ///     Worker positions (structure-of-arrays, problem_size x dimension).
+    /// @param tasks
+    ///     Task positions (structure-of-arrays, problem_size x dimension).
+    /// @param scale
+    ///     The factor distances are multiplied by before rounding.
+    /// @param candidate_count
+    ///     The number of nearest tasks initially considered per worker.
+    /// @param[out] assignment
+    ///     An output buffer for the minimum cost assignment.
+    void solve_for_minimum_metric_cost_assignment_sparsely(
+        Metric        metric,
+        unsigned int  problem_size,
+        unsigned int  dimension,
+        const float*  workers,
+        const float*  tasks,
+        float         scale,
+        unsigned int  candidate_count,
+        unsigned int* assignment);
+    /// Solves the assignment problem where the cost of assigning worker i to
+    /// task j is their quantized distance, round(scale * distance(i, j)),
+    /// to within the specified relative gap of the optimum, by coarsening,
+    /// solving coarsely and refining.
+    ///
+    /// Each two workers, and each two tasks, adjacent in kd-tree order are
+    /// merged at their centroid, and the coarser problem is solved likewise,
+    /// down to about a thousand points, where it is solved as by
+    /// solve_for_minimum_metric_cost_assignment_sparsely(). Each level then
+    /// takes the tasks merged into the coarse task of each worker's as extra
+    /// candidates, and the coarse column potentials as its own, from which
+    /// augmenting row reduction assigns most workers, and the shortest
+    /// augmenting paths left among neighboring clusters are short. Pruned
+    /// pairs that could improve the result are then added, and searched
+    /// again, until (U - L) / U <= relative_gap_tolerance, where L and U are
+    /// the bounds returned. A tolerance of zero finds an optimal assignment.
+    ///
+    /// Cosine distances are not supported by the kd-tree, so for them this
+    /// solves the full problem instead.
+    ///
+    /// @param metric
+    ///     The distance metric.
+    /// @param problem_size
+    ///     The number of workers/tasks.
+    /// @param dimension
+    ///     The number of coordinates per point.
+    /// @param workers
+    ///     Worker positions (structure-of-arrays, problem_size x dimension).
+    /// @param tasks
+    ///     Task positions (structure-of-arrays, problem_size x dimension).
+    /// @param scale
+    ///     The factor distances are multiplied by before rounding.
+    /// @param candidate_count
+    ///     The number of nearest tasks initially considered per worker.
+    /// @param relative_gap_tolerance
+    ///     The relative gap between the bounds to stop at.
+    /// @param[out] assignment
+    ///     An output buffer for the assignment found.
+    ///
+    /// Returns the cost of the assignment found, and a lower bound on that
+    /// of an optimal one.
+    CostBounds solve_for_metric_cost_assignment_by_levels(
+        Metric        metric,
+        unsigned int  problem_size,
+        unsigned int  dimension,
+        const float*  workers,
+        const float*  tasks,
+        float         scale,
+        unsigned int  candidate_count,
+        double        relative_gap_tolerance,
+        unsigned int* assignment);
+}
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <limits>
+
+
+/// Contains sensitivity analysis of optimal assignments.
+///
+/// Given an optimal assignment and dual potentials u, v certifying it (see
+/// verify()), the reduced cost of pair (i, j) is C(i, j) - u(i) - v(j) >= 0,
+/// and is zero for assigned pairs. Changing a single cost C(i, j) leaves the
+/// assignment optimal as long as:
+///
+/// - for an unassigned pair, C(i, j) decreases by at most the extra cost of
+///   the cheapest assignment that assigns worker i to task j. That is the
+///   reduced cost of (i, j) plus the length, in reduced costs, of the
+///   shortest alternating path closing the cycle that (i, j) opens.
+/// - for an assigned pair, C(i, j) increases by at most the extra cost of the
+///   cheapest assignment that does not assign worker i to task j: the least
+///   of the above over the other pairs in row i.
+///
+/// Increasing the cost of an unassigned pair, or decreasing the cost of an
+/// assigned one, never changes the optimal assignment.
+namespace rharel::hungarian_algorithm
+{
+    /// Denotes a cost change that cannot change the optimal assignment.
+    constexpr unsigned long long unlimited_cost_change =
+        std::numeric_limits<unsigned long long>::max();
+
+    /// Computes by how much each cost may change, on its own, before the
+    /// specified optimal assignment stops being optimal.
+    ///
+    /// Takes O(n^3) time and O(n) memory beyond the output: one Dijkstra
+    /// search over reduced costs per column.
+    ///
+    /// @param problem_size
+    ///     The number of workers/tasks.
+    /// @param cost_matrix
+    ///     A square matrix with problem_size rows and columns. Member (i, j)
+    ///     represents the cost of assigning worker i to task j.
+    /// @param assignment
+    ///     An optimal assignment.
+    /// @param row_potentials
+    ///     The dual variables u of rows, certifying the assignment.
+    /// @param column_potentials
+    ///     The dual variables v of columns, certifying the assignment.
+    /// @param[out] tolerances
+    ///     A square output matrix with problem_size rows and columns. Member
+    ///     (i, j) receives by how much C(i, j) may decrease if worker i is
+    ///     not assigned task j, or increase if it is, with the assignment
+    ///     remaining optimal (possibly tied with others). It is
+    ///     unlimited_cost_change if no such change matters, as for the sole
+    ///     pair of a 1x1 problem.
+    void compute_cost_tolerances(
+        unsigned int                     problem_size,
+        const unsigned int* const* const cost_matrix,
+        const unsigned int*              assignment,
+        const long long*                 row_potentials,
+        const long long*                 column_potentials,
+        unsigned long long**             tolerances);
+}
@@ -0,0 +1,71 @@
+#pragma once
+
+
+/// Contains solving of assignment problems on submatrices of a larger cost
+/// matrix, without copying them.
+namespace rharel::hungarian_algorithm
+{
+    /// A square submatrix of a cost matrix, selected by lists of row and
+    /// column indices. Neither the matrix nor the lists are copied, so they
+    /// must outlive the view.
+    ///
+    /// Member (a, b) of the view is member (rows[a], columns[b]) of the
+    /// matrix. The view is a cost function, so it may also be passed
+    /// wherever a CostComputer is expected.
+    class SubmatrixView
+    {
+        public:
+        /// Creates a new view of the specified cost matrix.
+        ///
+        /// @param cost_matrix
+        ///     The viewed matrix.
+        /// @param size
+        ///     The number of selected rows/columns.
+        /// @param rows
+        ///     The indices of selected rows in the matrix, size of them.
+        /// @param columns
+        ///     The indices of selected columns in the matrix, size of them.
+        SubmatrixView(const unsigned int* const* const cost_matrix,
+                      const unsigned int               size,
+                      const unsigned int* const        rows,
+                      const unsigned int* const        columns)
+            : C(cost_matrix), n(size), rows(rows), columns(columns)
+        {}
+
+        /// Gets member (a, b) of the view.
+        unsigned int operator()(const unsigned int a,
+                                const unsigned int b) const
+        {
+            return C[rows[a]][columns[b]];
+        }
+
+        /// Gets the number of selected rows/columns.
+        unsigned int size() const { return n; }
+        /// Gets the index in the matrix of row a of the view.
+        unsigned int row(const unsigned int a) const { return rows[a]; }
+        /// Gets the index in the matrix of column b of the view.
+        unsigned int column(const unsigned int b) const { return columns[b]; }
+
+        private:
+        const unsigned int* const* C;  // Viewed matrix.
+        unsigned int               n;  // Number of selected rows/columns.
+        const unsigned int*        rows;
+        const unsigned int*        columns;
+    };
+
+    /// Solves the assignment problem on a submatrix view, by successive
+    /// shortest augmenting paths, which only read costs.
+    ///
+    /// @param view
+    ///     The cost matrix of the problem.
+    /// @param[out] assignment
+    ///     An output buffer indexed by rows of the viewed matrix. For each
+    ///     selected row i = view.row(a), member i receives the index in the
+    ///     viewed matrix of the column assigned to it. Other members are left
+    ///     untouched, so views of disjoint rows may share a buffer.
+    ///
+    /// Returns the total cost of the assignment.
+    unsigned long long solve_for_minimum_cost_assignment(
+        const SubmatrixView& view,
+        unsigned int*        assignment);
+}
@@ -0,0 +1,94 @@
+#pragma once
+
+#include <chrono>
+#include <mutex>
+#include <ostream>
+#include <thread>
+#include <vector>
+
+
+namespace rharel::hungarian_algorithm
+{
+    /// Records a timeline of solver execution as begin/end events, and
+    /// writes it in the Chrome trace event format [1]. Traces can be viewed
+    /// in chrome://tracing or https://ui.perfetto.dev.
+    ///
+    /// Tracing is opt-in: solvers only record events when handed a tracer.
+    /// Events may be recorded from multiple threads at once; each thread is
+    /// shown on its own track.
+    ///
+    /// # References
+    /// 1. https://docs.google.com/document/d/1CvAClvFfyA5R-PhYUmn5OOQtYMH4h6I0nSsKchNAySU
+    class Tracer
+    {
+        public:
+        /// Creates a new tracer. Timestamps are relative to its creation.
+        Tracer();
+        Tracer(const Tracer&)            = delete;
+        Tracer& operator=(const Tracer&) = delete;
+
+        /// Records the beginning of a span on the calling thread.
+        ///
+        /// @param name
+        ///     The span's name. Must outlive the tracer (e.g. a literal).
+        /// @param category
+        ///     The span's category. Must outlive the tracer (e.g. a literal).
+        void begin(const char* name, const char* category);
+        /// Records the end of the innermost span begun on the calling thread.
+        void end();
+
+        /// Returns the number of recorded events.
+        std::size_t size() const;
+        /// Discards all recorded events.
+        void clear();
+
+        /// Writes the recorded events as a Chrome trace JSON object.
+        void write(std::ostream& stream) const;
+        /// Writes the recorded events to the specified file as a Chrome trace
+        /// JSON object. Returns true iff the file was written.
+        bool write(const char* path) const;
+
+        private:
+        /// A recorded event.
+        struct Event
+        {
+            const char*   name;      // Null for end events.
+            const char*   category;  // Null for end events.
+            double        timestamp; // In microseconds.
+            unsigned int  thread;    // Index into threads.
+        };
+
+        /// Records an event with the specified name and category.
+        void record(const char* name, const char* category);
+
+        const std::chrono::steady_clock::time_point start_time;
+
+        mutable std::mutex          mutex;    // Guards the members below.
+        std::vector<Event>          events;
+        std::vector<std::thread::id> threads;  // Threads seen so far.
+    };
+
+    /// Records a span over the lifetime of a scope, if given a tracer.
+    class TraceScope
+    {
+        public:
+        /// Begins a span on the specified tracer, unless it is null.
+        TraceScope(Tracer* const tracer,
+                   const char*   name,
+                   const char*   category)
+            : tracer(tracer)
+        {
+            if (tracer != nullptr) { tracer->begin(name, category); }
+        }
+        TraceScope(const TraceScope&)            = delete;
+        TraceScope& operator=(const TraceScope&) = delete;
+        /// Ends the span.
+        ~TraceScope()
+        {
+            if (tracer != nullptr) { tracer->end(); }
+        }
+
+        private:
+        Tracer* const tracer;
+    };
+}
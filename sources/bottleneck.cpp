@@ -0,0 +1,99 @@
+#include <algorithm>
+#include <vector>
+
+#include "../include/bottleneck.h"
+#include "../include/hopcroft_karp.hpp"
+
+
+using namespace rharel::hungarian_algorithm;
+
+
+unsigned int rharel::hungarian_algorithm::solve_for_bottleneck_assignment(
+    const unsigned int   problem_size,
+    unsigned int** const cost_matrix,
+    unsigned int*        assignment)
+{
+    using std::vector;
+    using detail::HopcroftKarp;
+
+    const unsigned int n = problem_size;
+    const unsigned int* const* const C = cost_matrix;
+    unsigned int* const              A = assignment;
+
+    if (n == 0) { return 0; }
+
+    // Every row and column is assigned one of its costs, so the bottleneck
+    // is at least the largest of their minima.
+    unsigned int least_bottleneck = 0;
+    vector<unsigned int> column_minimum(C[0], C[0] + n);
+    for (unsigned int i = 0; i < n; ++i)
+    {
+        unsigned int row_minimum = C[i][0];
+        for (unsigned int j = 0; j < n; ++j)
+        {
+            row_minimum       = std::min(row_minimum, C[i][j]);
+            column_minimum[j] = std::min(column_minimum[j], C[i][j]);
+        }
+        least_bottleneck = std::max(least_bottleneck, row_minimum);
+    }
+    for (unsigned int j = 0; j < n; ++j)
+    {
+        least_bottleneck = std::max(least_bottleneck, column_minimum[j]);
+    }
+
+    vector<unsigned int> thresholds;
+    for (unsigned int i = 0; i < n; ++i)
+    {
+        for (unsigned int j = 0; j < n; ++j)
+        {
+            if (C[i][j] >= least_bottleneck) { thresholds.push_back(C[i][j]); }
+        }
+    }
+    std::sort(thresholds.begin(), thresholds.end());
+    thresholds.erase(std::unique(thresholds.begin(), thresholds.end()),
+                     thresholds.end());
+
+    // Searches for the least threshold with a perfect matching. The largest
+    // always has one. The matching of the largest threshold found too low
+    // seeds the search at every larger one.
+    HopcroftKarp below(n);
+    HopcroftKarp best(n);   // Perfect at the high threshold, once found.
+    bool         has_best = false;
+    std::size_t low = 0, high = thresholds.size() - 1;
+    while (low < high)
+    {
+        const std::size_t  middle    = low + (high - low) / 2;
+        const unsigned int threshold = thresholds[middle];
+
+        HopcroftKarp matching = below;
+        matching.maximize([C, threshold](const unsigned int i,
+                                         const unsigned int j)
+        {
+            return C[i][j] <= threshold;
+        });
+        if (matching.size() == n)
+        {
+            high     = middle;
+            best     = std::move(matching);
+            has_best = true;
+        }
+        else
+        {
+            low   = middle + 1;
+            below = std::move(matching);
+        }
+    }
+    if (!has_best)
+    {
+        const unsigned int threshold = thresholds[high];
+        best = std::move(below);
+        best.maximize([C, threshold](const unsigned int i,
+                                     const unsigned int j)
+        {
+            return C[i][j] <= threshold;
+        });
+    }
+
+    for (unsigned int i = 0; i < n; ++i) { A[i] = best.column(i); }
+    return thresholds[high];
+}
@@ -0,0 +1,640 @@
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <new>
+#include <vector>
+
+#ifdef _WIN32
+    #ifndef NOMINMAX
+    #define NOMINMAX
+    #endif
+    #include <windows.h>
+#else
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+#include "../include/cost_matrix_file.h"
+#include "../include/hungarian_algorithm.h"
+
+
+using namespace rharel::hungarian_algorithm;
+
+
+/// Contains private implementation details.
+namespace rharel::hungarian_algorithm::detail
+{
+    /// The magic bytes a cost matrix record starts with.
+    constexpr char cost_matrix_magic[8] = 
+        { 'H', 'U', 'N', 'G', 'C', 'O', 'S', 'T' };
+    /// The cost matrix format version.
+    constexpr std::uint32_t cost_matrix_version = 1;
+    /// Rows and records are padded to a multiple of this many bytes.
+    constexpr unsigned int cost_matrix_alignment = 64;
+
+    /// The fields of a cost matrix record header.
+    struct CostMatrixHeader
+    {
+        CostEncoding  encoding;
+        std::uint32_t n;
+        std::uint32_t stride;
+        std::uint64_t payload_size;
+    };
+
+    /// Reads a little-endian unsigned integer.
+    template <typename Integer>
+    inline Integer read_little_endian(const unsigned char* bytes)
+    {
+        Integer value = 0;
+        for (unsigned int b = 0; b < sizeof(Integer); ++b)
+        {
+            value |= static_cast<Integer>(bytes[b]) << (8 * b);
+        }
+        return value;
+    }
+    /// Writes a little-endian unsigned integer.
+    template <typename Integer>
+    inline void write_little_endian(const Integer value, unsigned char* bytes)
+    {
+        for (unsigned int b = 0; b < sizeof(Integer); ++b)
+        {
+            bytes[b] = static_cast<unsigned char>(value >> (8 * b));
+        }
+    }
+
+    /// Rounds the specified size up to a multiple of the alignment.
+    inline std::uint64_t padded(const std::uint64_t size)
+    {
+        return (size + cost_matrix_alignment - 1) / 
+               cost_matrix_alignment * cost_matrix_alignment;
+    }
+
+    /// Returns true iff the specified encoding is a fixed-width one.
+    inline bool is_fixed_width(const CostEncoding encoding)
+    {
+        return encoding == CostEncoding::UInt8  ||
+               encoding == CostEncoding::UInt16 ||
+               encoding == CostEncoding::UInt32;
+    }
+    /// Returns true iff the specified value names an encoding.
+    inline bool is_encoding(const std::uint32_t value)
+    {
+        const CostEncoding encoding = static_cast<CostEncoding>(value);
+        return is_fixed_width(encoding)            || 
+               encoding == CostEncoding::Varint    ||
+               encoding == CostEncoding::DeltaVarint;
+    }
+
+    /// Parses and validates a record header.
+    /// Returns true iff it is valid.
+    bool parse_header(const unsigned char* bytes, CostMatrixHeader& header)
+    {
+        if (std::memcmp(bytes, cost_matrix_magic, 8) != 0 ||
+            read_little_endian<std::uint32_t>(bytes + 8) != 
+                cost_matrix_version ||
+            !is_encoding(read_little_endian<std::uint32_t>(bytes + 12)))
+        {
+            return false;
+        }
+        header.encoding     = static_cast<CostEncoding>(
+                              read_little_endian<std::uint32_t>(bytes + 12));
+        header.n            = read_little_endian<std::uint32_t>(bytes + 16);
+        header.stride       = read_little_endian<std::uint32_t>(bytes + 20);
+        header.payload_size = read_little_endian<std::uint64_t>(bytes + 24);
+
+        const std::uint64_t n      = header.n,
+                            stride = header.stride;
+        if (is_fixed_width(header.encoding))
+        {
+            const std::uint64_t width = 
+                static_cast<std::uint64_t>(header.encoding);
+            return stride >= n &&
+                   (n == 0 || stride <= UINT64_MAX / width / n) &&
+                   header.payload_size == stride * width * n;
+        }
+        else
+        {
+            // Each cost takes between 1 and 10 bytes.
+            return stride == n && 
+                   header.payload_size >= n * n &&
+                   header.payload_size / 10 <= n * n;
+        }
+    }
+
+    /// Appends an unsigned LEB128 varint.
+    inline void append_varint(std::uint64_t value, 
+                              std::vector<unsigned char>& bytes)
+    {
+        while (value >= 0x80)
+        {
+            bytes.push_back(static_cast<unsigned char>(value | 0x80));
+            value >>= 7;
+        }
+        bytes.push_back(static_cast<unsigned char>(value));
+    }
+    /// Reads an unsigned LEB128 varint, advancing the specified position.
+    /// Returns true iff a varint was read before the specified end.
+    inline bool read_varint(const unsigned char*& position,
+                            const unsigned char*  end,
+                            std::uint64_t&        value)
+    {
+        value = 0;
+        for (unsigned int shift = 0; shift < 64 && position != end; 
+             shift += 7)
+        {
+            const unsigned char byte = *position++;
+            value |= static_cast<std::uint64_t>(byte & 0x7F) << shift;
+            if ((byte & 0x80) == 0) { return true; }
+        }
+        return false;
+    }
+
+    /// Decodes a variable-width payload of n^2 costs.
+    /// Returns true iff the payload is valid.
+    bool decode_varints(const CostEncoding          encoding,
+                        const unsigned int          n,
+                        const unsigned char*        payload,
+                        const std::uint64_t         payload_size,
+                        std::vector<unsigned int>&  costs)
+    {
+        const unsigned char*       position = payload;
+        const unsigned char* const end      = payload + payload_size;
+
+        costs.resize(static_cast<std::size_t>(n) * n);
+        for (unsigned int i = 0; i < n; ++i)
+        {
+            long long previous = 0;
+            for (unsigned int j = 0; j < n; ++j)
+            {
+                std::uint64_t value;
+                if (!read_varint(position, end, value)) { return false; }
+
+                const long long greatest_cost = UINT32_MAX;
+                long long       cost;
+                if (encoding == CostEncoding::DeltaVarint && j > 0)
+                {
+                    const long long delta = 
+                        static_cast<long long>(value >> 1) ^ 
+                        -static_cast<long long>(value & 1);
+                    // Checked before adding, so the sum cannot overflow.
+                    if (delta < -previous || delta > greatest_cost - previous)
+                    {
+                        return false;
+                    }
+                    cost = previous + delta;
+                }
+                else
+                {
+                    if (value > static_cast<std::uint64_t>(greatest_cost)) 
+                    { 
+                        return false; 
+                    }
+                    cost = static_cast<long long>(value);
+                }
+
+                costs[static_cast<std::size_t>(i) * n + j] = 
+                    static_cast<unsigned int>(cost);
+                previous = cost;
+            }
+        }
+        return position == end;
+    }
+
+    /// Reads costs of a fixed-width encoding straight from a payload.
+    ///
+    /// Payloads are little-endian; so are all hosts we build for, so costs 
+    /// are loaded as they are.
+    template <typename Cost>
+    struct FixedWidthCost
+    {
+        const unsigned char* payload;
+        std::size_t          stride;
+
+        unsigned int operator()(const unsigned int i, 
+                                const unsigned int j) const
+        {
+            Cost cost;
+            std::memcpy(&cost, payload + (i * stride + j) * sizeof(Cost), 
+                        sizeof(Cost));
+            return cost;
+        }
+    };
+
+    /// Makes a view of a record whose header has been validated.
+    /// Variable-width payloads are decoded into the specified storage.
+    /// Returns true iff the payload is valid.
+    bool make_view(const CostMatrixHeader&    header,
+                   const unsigned char*       payload,
+                   std::vector<unsigned int>& decoded,
+                   CostMatrixView&            view)
+    {
+        if (is_fixed_width(header.encoding))
+        {
+            view = CostMatrixView(header.n, header.stride, header.encoding, 
+                                  payload);
+            return true;
+        }
+        if (!decode_varints(header.encoding, header.n, payload, 
+                            header.payload_size, decoded))
+        {
+            return false;
+        }
+        view = CostMatrixView(
+            header.n, header.n, CostEncoding::UInt32, 
+            reinterpret_cast<const unsigned char*>(decoded.data())
+        );
+        return true;
+    }
+
+    #ifndef _WIN32
+    /// Translates an access advice to its madvise() counterpart.
+    inline int to_madvise_advice(const AccessAdvice advice)
+    {
+        switch (advice)
+        {
+            case AccessAdvice::Sequential: { return MADV_SEQUENTIAL; }
+            case AccessAdvice::Random:     { return MADV_RANDOM;     }
+            case AccessAdvice::WillNeed:   { return MADV_WILLNEED;   }
+            default:                       { return MADV_NORMAL;     }
+        }
+    }
+    #endif
+}
+
+
+unsigned int CostMatrixView::operator()(const unsigned int i, 
+                                        const unsigned int j) const
+{
+    switch (cost_encoding)
+    {
+        case CostEncoding::UInt8:  
+        { 
+            return detail::FixedWidthCost<std::uint8_t> { 
+                data, row_stride }(i, j); 
+        }
+        case CostEncoding::UInt16: 
+        { 
+            return detail::FixedWidthCost<std::uint16_t> { 
+                data, row_stride }(i, j); 
+        }
+        default:                   
+        { 
+            return detail::FixedWidthCost<std::uint32_t> { 
+                data, row_stride }(i, j); 
+        }
+    }
+}
+
+CostMatrixWriter::CostMatrixWriter(std::ostream& stream) : stream(stream) {}
+bool CostMatrixWriter::write(const unsigned int               problem_size,
+                             const unsigned int* const* const cost_matrix,
+                             const CostEncoding               encoding)
+{
+    using namespace detail;
+
+    const unsigned int n = problem_size;
+    if (!is_encoding(static_cast<std::uint32_t>(encoding))) { return false; }
+
+    payload.clear();
+    std::uint32_t stride = n;
+    if (is_fixed_width(encoding))
+    {
+        const unsigned int  width        = static_cast<unsigned int>(encoding);
+        const std::uint64_t maximum_cost = (1ull << (8 * width)) - 1;
+        const std::size_t   row_size     = 
+            padded(static_cast<std::uint64_t>(n) * width);
+        stride = static_cast<std::uint32_t>(row_size / width);
+
+        payload.resize(row_size * n, 0);
+        for (unsigned int i = 0; i < n; ++i)
+        {
+            unsigned char* const row = &payload[row_size * i];
+            for (unsigned int j = 0; j < n; ++j)
+            {
+                const unsigned int cost = cost_matrix[i][j];
+                if (cost > maximum_cost) { return false; }
+
+                unsigned char* const bytes = row + 
+                    static_cast<std::size_t>(j) * width;
+                switch (encoding)
+                {
+                    case CostEncoding::UInt8:  
+                    { 
+                        bytes[0] = static_cast<unsigned char>(cost); 
+                        break; 
+                    }
+                    case CostEncoding::UInt16: 
+                    { 
+                        write_little_endian<std::uint16_t>(
+                            static_cast<std::uint16_t>(cost), bytes); 
+                        break; 
+                    }
+                    default: 
+                    { 
+                        write_little_endian<std::uint32_t>(cost, bytes); 
+                        break; 
+                    }
+                }
+            }
+        }
+    }
+    else
+    {
+        for (unsigned int i = 0; i < n; ++i)
+        {
+            long long previous = 0;
+            for (unsigned int j = 0; j < n; ++j)
+            {
+                const long long cost = cost_matrix[i][j];
+                if (encoding == CostEncoding::DeltaVarint && j > 0)
+                {
+                    // Zigzag encoding maps small differences of either sign
+                    // to small unsigned values.
+                    const long long delta = cost - previous;
+                    append_varint((static_cast<std::uint64_t>(delta) << 1) ^
+                                  static_cast<std::uint64_t>(delta >> 63), 
+                                  payload);
+                }
+                else 
+                { 
+                    append_varint(static_cast<std::uint64_t>(cost), payload); 
+                }
+                previous = cost;
+            }
+        }
+    }
+
+    unsigned char header[cost_matrix_header_size] = {};
+    std::memcpy(header, cost_matrix_magic, 8);
+    write_little_endian<std::uint32_t>(cost_matrix_version, header + 8);
+    write_little_endian<std::uint32_t>(
+        static_cast<std::uint32_t>(encoding),               header + 12);
+    write_little_endian<std::uint32_t>(n,                   header + 16);
+    write_little_endian<std::uint32_t>(stride,              header + 20);
+    write_little_endian<std::uint64_t>(payload.size(),      header + 24);
+
+    const unsigned char padding[cost_matrix_alignment] = {};
+    stream.write(reinterpret_cast<const char*>(header), sizeof(header));
+    stream.write(reinterpret_cast<const char*>(payload.data()), 
+                 static_cast<std::streamsize>(payload.size()));
+    stream.write(reinterpret_cast<const char*>(padding),
+                 static_cast<std::streamsize>(
+                     padded(payload.size()) - payload.size()));
+    return static_cast<bool>(stream);
+}
+
+CostMatrixReader::CostMatrixReader(const unsigned char* buffer, 
+                                   const std::size_t    size)
+    : buffer(buffer), size(size)
+{}
+bool CostMatrixReader::next(CostMatrixView& view)
+{
+    using namespace detail;
+
+    if (has_failed || offset == size) { return false; }
+
+    CostMatrixHeader header;
+    if (size - offset < cost_matrix_header_size ||
+        !parse_header(buffer + offset, header) ||
+        header.payload_size > size - offset - cost_matrix_header_size ||
+        !make_view(header, buffer + offset + cost_matrix_header_size, 
+                   decoded, view))
+    {
+        has_failed = true;
+        return false;
+    }
+    const std::uint64_t record_size = 
+        cost_matrix_header_size + padded(header.payload_size);
+    offset = record_size < size - offset ? offset + record_size : size;
+    return true;
+}
+
+CostMatrixStreamReader::CostMatrixStreamReader(std::istream& stream) 
+    : stream(stream)
+{}
+bool CostMatrixStreamReader::next(CostMatrixView& view)
+{
+    using namespace detail;
+
+    if (has_failed) { return false; }
+
+    unsigned char header_bytes[cost_matrix_header_size];
+    stream.read(reinterpret_cast<char*>(header_bytes), sizeof(header_bytes));
+    if (stream.gcount() == 0 && stream.eof()) { return false; }
+
+    CostMatrixHeader header;
+    if (stream.gcount() != sizeof(header_bytes) || 
+        !parse_header(header_bytes, header))
+    {
+        has_failed = true;
+        return false;
+    }
+    // A header may claim more than fits in memory; that is no valid record
+    // either.
+    bool is_valid;
+    try
+    {
+        is_valid = read_payload(header.payload_size) &&
+                   make_view(header, record.data(), decoded, view);
+    }
+    catch (const std::bad_alloc&) { is_valid = false; }
+    if (!is_valid)
+    {
+        has_failed = true;
+        return false;
+    }
+    stream.ignore(static_cast<std::streamsize>(
+        padded(header.payload_size) - header.payload_size));
+    return true;
+}
+
+bool CostMatrixStreamReader::read_payload(const std::uint64_t payload_size)
+{
+    // The header alone does not show that the payload exists, so the record
+    // grows in chunks, each at most as large as what has arrived so far.
+    constexpr std::size_t least_chunk_size = 1 << 16;
+
+    record.clear();
+    if (payload_size > record.max_size()) { return false; }
+    while (record.size() < payload_size)
+    {
+        const std::size_t offset = record.size();
+        const std::size_t count  = static_cast<std::size_t>(
+            std::min<std::uint64_t>(payload_size - offset,
+                                    std::max(least_chunk_size, offset))
+        );
+        record.resize(offset + count);
+        stream.read(reinterpret_cast<char*>(record.data() + offset),
+                    static_cast<std::streamsize>(count));
+        if (static_cast<std::size_t>(stream.gcount()) != count)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool rharel::hungarian_algorithm::write_cost_matrix_file(
+    const char*                      path,
+    const unsigned int               problem_size,
+    const unsigned int* const* const cost_matrix,
+    const CostEncoding               encoding)
+{
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file) { return false; }
+
+    return CostMatrixWriter(file).write(problem_size, cost_matrix, encoding);
+}
+
+MappedCostMatrix::~MappedCostMatrix() { close(); }
+bool MappedCostMatrix::open(const char* path, const AccessAdvice advice)
+{
+    close();
+
+    #ifdef _WIN32
+    file_handle = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, nullptr,
+                              OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file_handle == INVALID_HANDLE_VALUE) 
+    { 
+        file_handle = nullptr; 
+        return false; 
+    }
+    LARGE_INTEGER file_size;
+    if (!GetFileSizeEx(file_handle, &file_size) || file_size.QuadPart == 0) 
+    { 
+        close(); 
+        return false; 
+    }
+    mapping_handle = CreateFileMappingA(file_handle, nullptr, PAGE_READONLY, 
+                                        0, 0, nullptr);
+    if (mapping_handle == nullptr) { close(); return false; }
+    
+    data = static_cast<const unsigned char*>(
+        MapViewOfFile(mapping_handle, FILE_MAP_READ, 0, 0, 0)
+    );
+    if (data == nullptr) { close(); return false; }
+    data_size = static_cast<std::uint64_t>(file_size.QuadPart);
+    #else
+    const int file = ::open(path, O_RDONLY);
+    if (file < 0) { return false; }
+
+    struct stat file_status;
+    if (fstat(file, &file_status) != 0 || file_status.st_size <= 0) 
+    { 
+        ::close(file); 
+        return false; 
+    }
+    void* const mapping = mmap(nullptr, file_status.st_size, PROT_READ, 
+                               MAP_SHARED, file, 0);
+    ::close(file);  // The mapping keeps the file open.
+    if (mapping == MAP_FAILED) { return false; }
+
+    data      = static_cast<const unsigned char*>(mapping);
+    data_size = static_cast<std::uint64_t>(file_status.st_size);
+    #endif
+
+    detail::CostMatrixHeader header;
+    if (data_size < cost_matrix_header_size ||
+        !detail::parse_header(data, header) ||
+        !detail::is_fixed_width(header.encoding) ||
+        header.payload_size > data_size - cost_matrix_header_size)
+    {
+        close();
+        return false;
+    }
+    matrix = CostMatrixView(header.n, header.stride, header.encoding, 
+                            data + cost_matrix_header_size);
+
+    advise(advice, 0, header.n);
+    return true;
+}
+void MappedCostMatrix::close()
+{
+    #ifdef _WIN32
+    if (data           != nullptr) { UnmapViewOfFile(data);       }
+    if (mapping_handle != nullptr) { CloseHandle(mapping_handle); }
+    if (file_handle    != nullptr) { CloseHandle(file_handle);    }
+    mapping_handle = nullptr;
+    file_handle    = nullptr;
+    #else
+    if (data != nullptr) 
+    { 
+        munmap(const_cast<unsigned char*>(data), data_size); 
+    }
+    #endif
+    data      = nullptr;
+    data_size = 0;
+    matrix    = CostMatrixView();
+}
+void MappedCostMatrix::advise(const AccessAdvice advice,
+                              const unsigned int first_row,
+                              const unsigned int row_count) const
+{
+    #ifdef _WIN32
+    (void) advice; (void) first_row; (void) row_count;
+    #else
+    const unsigned int n = matrix.size();
+    if (data == nullptr || first_row >= n) { return; }
+
+    const std::size_t width     = static_cast<std::size_t>(matrix.encoding());
+    const std::size_t row_size  = matrix.stride() * width;
+    const std::size_t last_row  = 
+        first_row + std::min<std::size_t>(row_count, n - first_row);
+    const std::size_t page_size = 
+        static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+
+    // madvise() requires a page-aligned start.
+    std::size_t begin = cost_matrix_header_size + first_row * row_size;
+    std::size_t end   = cost_matrix_header_size + last_row  * row_size;
+    begin -= begin % page_size;
+
+    madvise(const_cast<unsigned char*>(data) + begin, end - begin, 
+            detail::to_madvise_advice(advice));
+    #endif
+}
+void rharel::hungarian_algorithm::solve_for_minimum_cost_assignment(
+    const CostMatrixView& cost_matrix,
+    unsigned int*         assignment)
+{
+    using detail::FixedWidthCost;
+
+    const unsigned int   n       = cost_matrix.size();
+    const unsigned char* payload = cost_matrix.payload();
+    const std::size_t    stride  = cost_matrix.stride();
+
+    // The costs are already in memory, or in the page cache when mapped, so
+    // no row cache is kept on top of them.
+    switch (cost_matrix.encoding())
+    {
+        case CostEncoding::UInt8:
+        {
+            solve_for_minimum_cost_assignment_lazily(
+                n, FixedWidthCost<std::uint8_t> { payload, stride }, 
+                /* cached_row_count: */ 0, assignment);
+            break;
+        }
+        case CostEncoding::UInt16:
+        {
+            solve_for_minimum_cost_assignment_lazily(
+                n, FixedWidthCost<std::uint16_t> { payload, stride }, 
+                /* cached_row_count: */ 0, assignment);
+            break;
+        }
+        default:
+        {
+            solve_for_minimum_cost_assignment_lazily(
+                n, FixedWidthCost<std::uint32_t> { payload, stride }, 
+                /* cached_row_count: */ 0, assignment);
+            break;
+        }
+    }
+}
+void rharel::hungarian_algorithm::solve_for_minimum_cost_assignment(
+    const MappedCostMatrix& cost_matrix,
+    unsigned int*           assignment)
+{
+    solve_for_minimum_cost_assignment(cost_matrix.view(), assignment);
+}
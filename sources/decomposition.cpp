@@ -0,0 +1,340 @@
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "../include/decomposition.h"
+#include "../include/hopcroft_karp.hpp"
+#include "../include/hungarian_algorithm.h"
+#include "../include/submatrix_view.h"
+
+
+using namespace rharel::hungarian_algorithm;
+
+
+/// Contains private implementation details.
+namespace rharel::hungarian_algorithm::detail
+{
+    /// Assigns each row or column with a single allowed pair that pair,
+    /// which any assignment avoiding forbidden pairs must include, and
+    /// removes both from the problem. Repeats while that leaves others with
+    /// a single allowed pair. Takes O(n^2) time.
+    ///
+    /// Returns false iff a row or column is left with no allowed pairs.
+    bool assign_forced_pairs(const unsigned int               n,
+                             const unsigned int* const* const C,
+                             unsigned int* const              A,
+                             std::vector<bool>&               is_active_row,
+                             std::vector<bool>&               is_active_column)
+    {
+        std::vector<unsigned int> row_degree(n, 0), column_degree(n, 0);
+        for (unsigned int i = 0; i < n; ++i)
+        {
+            for (unsigned int j = 0; j < n; ++j)
+            {
+                if (C[i][j] == forbidden_cost) { continue; }
+                ++ row_degree[i];
+                ++ column_degree[j];
+            }
+        }
+        // Rows are elements 0..n-1 and columns n..2n-1.
+        std::vector<unsigned int> forced;
+        for (unsigned int x = 0; x < n; ++x)
+        {
+            if (row_degree[x] == 0 || column_degree[x] == 0) { return false; }
+            if (row_degree[x]    == 1) { forced.push_back(x); }
+            if (column_degree[x] == 1) { forced.push_back(n + x); }
+        }
+        while (!forced.empty())
+        {
+            const unsigned int x = forced.back();
+            forced.pop_back();
+
+            unsigned int i = x, j = x - n;
+            if (x < n)
+            {
+                if (!is_active_row[i]) { continue; }
+                for (j = 0; j < n; ++j)
+                {
+                    if (is_active_column[j] && C[i][j] != forbidden_cost)
+                    {
+                        break;
+                    }
+                }
+            }
+            else
+            {
+                if (!is_active_column[j]) { continue; }
+                for (i = 0; i < n; ++i)
+                {
+                    if (is_active_row[i] && C[i][j] != forbidden_cost)
+                    {
+                        break;
+                    }
+                }
+            }
+            A[i] = j;
+            is_active_row[i]    = false;
+            is_active_column[j] = false;
+
+            for (unsigned int r = 0; r < n; ++r)
+            {
+                if (!is_active_row[r] || C[r][j] == forbidden_cost)
+                {
+                    continue;
+                }
+                if (-- row_degree[r] == 0) { return false; }
+                if (row_degree[r] == 1)    { forced.push_back(r); }
+            }
+            for (unsigned int l = 0; l < n; ++l)
+            {
+                if (!is_active_column[l] || C[i][l] == forbidden_cost)
+                {
+                    continue;
+                }
+                if (-- column_degree[l] == 0) { return false; }
+                if (column_degree[l] == 1)    { forced.push_back(n + l); }
+            }
+        }
+        return true;
+    }
+
+    /// The rows and columns of a component.
+    struct Component
+    {
+        std::vector<unsigned int> rows, columns;
+    };
+
+    /// Splits the active rows and columns into components, given a perfect
+    /// matching of them, by Tarjan's algorithm in O(n^2) time.
+    ///
+    /// An allowed pair (i, j) that is not matched is in some assignment iff
+    /// it lies on a cycle alternating between matched and unmatched pairs.
+    /// So the components are the strongly connected ones of the graph with
+    /// an arc from row i to the row matched to column j, for each such pair,
+    /// each row taken with its matched column. Pairs between components are
+    /// in no assignment avoiding forbidden pairs, and are eliminated.
+    std::vector<Component> find_components(
+        const unsigned int               n,
+        const unsigned int* const* const C,
+        const HopcroftKarp&              matching,
+        const std::vector<bool>&         is_active_row,
+        const std::vector<bool>&         is_active_column)
+    {
+        const unsigned int unvisited = n;
+
+        std::vector<unsigned int> index(n, unvisited), least_index(n),
+                                  next_column(n, 0);
+        std::vector<bool>         is_on_stack(n, false);
+        std::vector<unsigned int> stack, path;
+        unsigned int              visited_count = 0;
+        std::vector<Component>    components;
+
+        const auto visit = [&](const unsigned int i)
+        {
+            index[i] = least_index[i] = visited_count++;
+            stack.push_back(i);
+            is_on_stack[i] = true;
+            path.push_back(i);
+        };
+        for (unsigned int root = 0; root < n; ++root)
+        {
+            if (!is_active_row[root] || index[root] != unvisited) { continue; }
+
+            visit(root);
+            while (!path.empty())
+            {
+                const unsigned int i = path.back();
+
+                // Follows the next arc from row i, if any.
+                unsigned int& j = next_column[i];
+                while (j < n && (!is_active_column[j]        ||
+                                 C[i][j] == forbidden_cost   ||
+                                 j == matching.column(i)))
+                {
+                    ++ j;
+                }
+                if (j < n)
+                {
+                    const unsigned int r = matching.row(j++);
+                    if (index[r] == unvisited) { visit(r); }
+                    else if (is_on_stack[r])
+                    {
+                        least_index[i] = std::min(least_index[i], index[r]);
+                    }
+                    continue;
+                }
+
+                path.pop_back();
+                if (!path.empty())
+                {
+                    unsigned int& parent_least_index = least_index[path.back()];
+                    parent_least_index = std::min(parent_least_index,
+                                                  least_index[i]);
+                }
+                if (least_index[i] != index[i]) { continue; }
+
+                // Row i is the first visited of its component.
+                components.emplace_back();
+                Component&   component = components.back();
+                unsigned int r;
+                do
+                {
+                    r = stack.back();
+                    stack.pop_back();
+                    is_on_stack[r] = false;
+                    component.rows.push_back(r);
+                    component.columns.push_back(matching.column(r));
+                }
+                while (r != i);
+            }
+        }
+        return components;
+    }
+
+    /// Solves the assignment problem restricted to a component.
+    /// Returns true iff it has an assignment avoiding forbidden pairs.
+    bool solve_component(const unsigned int* const* const C,
+                         const Component&                 component,
+                         unsigned int* const              A)
+    {
+        const auto m = static_cast<unsigned int>(component.rows.size());
+        const SubmatrixView view(C, m, component.rows.data(),
+                                 component.columns.data());
+
+        // Forbidden pairs cost more than any assignment without them, so
+        // they are only assigned if there is no such assignment.
+        long long greatest_cost = 0;
+        for (unsigned int a = 0; a < m; ++a)
+        {
+            for (unsigned int b = 0; b < m; ++b)
+            {
+                if (view(a, b) == forbidden_cost) { continue; }
+                greatest_cost = std::max(greatest_cost,
+                                         static_cast<long long>(view(a, b)));
+            }
+        }
+        const long long penalty = (greatest_cost + 1) * m;
+
+        std::vector<unsigned int> local_assignment(m);
+        solve_by_shortest_augmenting_paths(
+            m,
+            [&view, penalty](const unsigned int a, const unsigned int b)
+            {
+                const unsigned int cost = view(a, b);
+                return cost == forbidden_cost ? penalty
+                                              : static_cast<long long>(cost);
+            },
+            local_assignment.data()
+        );
+        for (unsigned int a = 0; a < m; ++a)
+        {
+            const unsigned int b = local_assignment[a];
+            if (view(a, b) == forbidden_cost) { return false; }
+            A[view.row(a)] = view.column(b);
+        }
+        return true;
+    }
+}
+
+bool rharel::hungarian_algorithm::assign_forced_pairs(
+    const unsigned int               problem_size,
+    const unsigned int* const* const cost_matrix,
+    unsigned int*                    assignment,
+    std::vector<unsigned int>&       residual_rows,
+    std::vector<unsigned int>&       residual_columns)
+{
+    const unsigned int n = problem_size;
+
+    residual_rows.clear();
+    residual_columns.clear();
+
+    std::vector<bool> is_active_row(n, true), is_active_column(n, true);
+    if (!detail::assign_forced_pairs(n, cost_matrix, assignment,
+                                     is_active_row, is_active_column))
+    {
+        return false;
+    }
+    for (unsigned int k = 0; k < n; ++k)
+    {
+        if (is_active_row[k])    { residual_rows.push_back(k); }
+        if (is_active_column[k]) { residual_columns.push_back(k); }
+    }
+    return true;
+}
+bool rharel::hungarian_algorithm::
+solve_for_minimum_cost_assignment_by_components(
+    const unsigned int               problem_size,
+    const unsigned int* const* const cost_matrix,
+    unsigned int*                    assignment,
+    const unsigned int               thread_count)
+{
+    using std::vector;
+    using detail::Component;
+    using detail::HopcroftKarp;
+    using detail::assign_forced_pairs;
+    using detail::find_components;
+    using detail::solve_component;
+
+    const unsigned int n = problem_size;
+    const unsigned int* const* const C = cost_matrix;
+
+    vector<bool> is_active_row(n, true), is_active_column(n, true);
+    if (!assign_forced_pairs(n, C, assignment,
+                             is_active_row, is_active_column))
+    {
+        return false;
+    }
+
+    // Rows confined to as many columns as there are of them take all of
+    // those columns, so the pairs of other rows in them are eliminated.
+    HopcroftKarp matching(n);
+    unsigned int active_row_count = 0;
+    for (unsigned int i = 0; i < n; ++i)
+    {
+        if (is_active_row[i]) { ++ active_row_count; }
+    }
+    const unsigned int matched_count = matching.maximize(
+        [&](const unsigned int i, const unsigned int j)
+        {
+            return is_active_row[i] && is_active_column[j] &&
+                   C[i][j] != forbidden_cost;
+        }
+    );
+    if (matched_count != active_row_count) { return false; }
+
+    vector<Component> components = find_components(
+        n, C, matching, is_active_row, is_active_column
+    );
+    std::sort(components.begin(), components.end(),
+              [](const Component& a, const Component& b)
+              {
+                  return a.rows.size() > b.rows.size();
+              });
+
+    // Threads take the next unsolved component, largest first.
+    std::atomic<std::size_t> next_component(0);
+    std::atomic<bool>        is_feasible(true);
+    const auto solve_components = [&]()
+    {
+        for (std::size_t k = next_component++; k < components.size();
+             k = next_component++)
+        {
+            if (!solve_component(C, components[k], assignment))
+            {
+                is_feasible = false;
+            }
+        }
+    };
+    vector<std::thread> threads;
+    const std::size_t used_thread_count =
+        std::min<std::size_t>(std::max(thread_count, 1u), components.size());
+    for (std::size_t t = 1; t < used_thread_count; ++t)
+    {
+        threads.emplace_back(solve_components);
+    }
+    solve_components();
+    for (auto& thread : threads) { thread.join(); }
+
+    return is_feasible;
+}
@@ -1,8 +1,19 @@
+#include <algorithm>
+#include <chrono>
 #include <limits>
 
+#include "../include/hopcroft_karp.hpp"
 #include "../include/hungarian_algorithm.h"
 
 
+/// Compiles the specified statements only if statistics are enabled.
+#ifdef HUNGARIAN_ALGORITHM_STATISTICS
+    #define RECORD(...) __VA_ARGS__
+#else
+    #define RECORD(...)
+#endif
+
+
 using namespace rharel::hungarian_algorithm;
 
 
@@ -16,14 +27,103 @@ void rharel::hungarian_algorithm::solve_for_minimum_cost_assignment(
 
     Problem(problem_size, cost_matrix).solve(assignment);
 }
+void rharel::hungarian_algorithm::solve_for_minimum_cost_assignment(
+    const unsigned int problem_size,
+    unsigned int**     cost_matrix,
+    unsigned int*      assignment,
+    Statistics&        statistics)
+{
+    statistics = Statistics();
+
+    if (problem_size == 0) {                    return; }
+    if (problem_size == 1) { assignment[0] = 0; return; }
+
+    Problem problem(problem_size, cost_matrix);
+    problem.solve(assignment);
+    statistics = problem.statistics();
+}
+unsigned long long rharel::hungarian_algorithm::
+solve_for_minimum_cost_assignment(
+    const unsigned int problem_size,
+    unsigned int**     cost_matrix,
+    unsigned int*      assignment,
+    long long*         row_potentials,
+    long long*         column_potentials)
+{
+    if (problem_size == 0) { return 0; }
+    if (problem_size == 1) 
+    { 
+        assignment[0] = 0; 
+        if (row_potentials    != nullptr) 
+        { 
+            row_potentials[0] = cost_matrix[0][0]; 
+        }
+        if (column_potentials != nullptr) { column_potentials[0] = 0; }
+        return cost_matrix[0][0]; 
+    }
+
+    Problem problem(problem_size, cost_matrix);
+    problem.solve(assignment);
+    if (row_potentials != nullptr)
+    {
+        std::copy(problem.row_potentials().begin(), 
+                  problem.row_potentials().end(), row_potentials);
+    }
+    if (column_potentials != nullptr)
+    {
+        std::copy(problem.column_potentials().begin(), 
+                  problem.column_potentials().end(), column_potentials);
+    }
+    return problem.lower_bound();
+}
+bool rharel::hungarian_algorithm::verify(
+    const unsigned int               problem_size,
+    const unsigned int* const* const cost_matrix,
+    const unsigned int*              assignment,
+    const long long*                 row_potentials,
+    const long long*                 column_potentials)
+{
+    const unsigned int n = problem_size;
+
+    std::vector<bool> is_assigned_column(n, false);
+    for (unsigned int i = 0; i < n; ++i)
+    {
+        const unsigned int j = assignment[i];
+        if (j >= n || is_assigned_column[j]) { return false; }
+        is_assigned_column[j] = true;
+    }
+    for (unsigned int i = 0; i < n; ++i)
+    {
+        const long long u = row_potentials[i];
+        for (unsigned int j = 0; j < n; ++j)
+        {
+            const long long reduced_cost = 
+                static_cast<long long>(cost_matrix[i][j]) - u - 
+                column_potentials[j];
+            if (reduced_cost < 0) { return false; }
+            if (reduced_cost > 0 && assignment[i] == j) { return false; }
+        }
+    }
+    return true;
+}
 
 Problem::Problem(const unsigned int size, 
                  unsigned int *const *const cost_matrix)
     : n(size), C(cost_matrix), S(n, n), P(n, n),
-      is_covered_row(n, false), is_covered_column(n, false)
+      is_covered_row(n, false), is_covered_column(n, false),
+      reduced_assignment(n), u(n, 0), v(n, 0)
 {}
 bool Problem::step()
 {
+    RECORD(
+        const int  performed_step = static_cast<int>(current_step);
+        const auto start_time     = std::chrono::steady_clock::now();
+    )
+    static const char* const step_names[] = {
+        "done", "step_1", "step_2", "step_3", "step_4", "step_5", "step_6"
+    };
+    const TraceScope span(tracer, step_names[static_cast<int>(current_step)],
+                          "munkres");
     switch (current_step)
     {
         case Step::One:   { current_step = step_1(); break; }
@@ -33,6 +133,13 @@ bool Problem::step()
         case Step::Five:  { current_step = step_5(); break; }
         case Step::Six:   { current_step = step_6(); break; }
     }
+    RECORD(
+        recorded_statistics.step_count[performed_step] += 1;
+        recorded_statistics.step_nanoseconds[performed_step] += 
+            std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now() - start_time
+            ).count();
+    )
     return current_step == Step::Done;
 }
 void Problem::solve(unsigned int *const assignment)
@@ -40,32 +147,165 @@ void Problem::solve(unsigned int *const assignment)
     while (current_step != Step::Done) { step(); }
     output_solution(assignment);
 }
+SolveStatus Problem::solve(
+    unsigned int *const                         assignment,
+    const std::chrono::steady_clock::time_point deadline)
+{
+    return solve(assignment, &deadline, nullptr);
+}
+SolveStatus Problem::solve(unsigned int *const      assignment,
+                           const CancellationToken& token)
+{
+    return solve(assignment, nullptr, &token);
+}
+SolveStatus Problem::solve(
+    unsigned int *const                                assignment,
+    const std::chrono::steady_clock::time_point* const deadline,
+    const CancellationToken* const                     token)
+{
+    while (current_step != Step::Done) 
+    {
+        if (token != nullptr && token->is_cancelled())
+        {
+            output_greedy_completion(assignment);
+            return SolveStatus::Cancelled;
+        }
+        if (deadline != nullptr && 
+            std::chrono::steady_clock::now() >= *deadline)
+        {
+            output_greedy_completion(assignment);
+            return SolveStatus::DeadlineExpired;
+        }
+        step(); 
+    }
+    output_solution(assignment);
+    return SolveStatus::Optimal;
+}
+SolveStatus Problem::solve(unsigned int *const assignment,
+                           const double        relative_gap_tolerance)
+{
+    std::vector<unsigned int> completion(n);
+    unsigned long long least_upper_bound = 
+        std::numeric_limits<unsigned long long>::max();
+    while (current_step != Step::Done)
+    {
+        const Step performed_step = current_step;
+        step();
+        if (performed_step != Step::Three || current_step == Step::Done ||
+            relative_gap_tolerance <= 0.0) { continue; }
+
+        // Step 3 has just counted the stars of a new augmentation (or of 
+        // step 2), so the completion may have improved.
+        const unsigned long long upper_bound = 
+            dual_objective + output_greedy_completion(completion.data());
+        if (upper_bound < least_upper_bound)
+        {
+            least_upper_bound = upper_bound;
+            std::copy(completion.begin(), completion.end(), assignment);
+        }
+        const unsigned long long gap = least_upper_bound - dual_objective;
+        if (gap <= relative_gap_tolerance * least_upper_bound)
+        {
+            return gap == 0 ? SolveStatus::Optimal 
+                            : SolveStatus::WithinTolerance;
+        }
+    }
+    output_solution(assignment);
+    return SolveStatus::Optimal;
+}
+const std::vector<long long>& Problem::row_potentials() const
+{
+    return u;
+}
+const std::vector<long long>& Problem::column_potentials() const
+{
+    return v;
+}
+unsigned long long Problem::lower_bound() const
+{
+    return dual_objective;
+}
+unsigned long long Problem::upper_bound() const
+{
+    std::vector<unsigned int> completion(n);
+    return dual_objective + output_greedy_completion(completion.data());
+}
+Problem::Step Problem::next_step() const
+{
+    return current_step;
+}
+const Statistics& Problem::statistics() const
+{
+    return recorded_statistics;
+}
+void Problem::trace(Tracer* const tracer)
+{
+    this->tracer = tracer;
+}
 Problem::Step Problem::step_1()
 {
     S.reserve(Eigen::VectorXi::Constant(n, 4));
     P.reserve(Eigen::VectorXi::Constant(n, 4));
 
+    std::vector<long long> reduction_u(n), reduction_v(n);
+    detail::initialize_by_reduction(
+        n,
+        [this](const unsigned int i, const unsigned int j)
+        {
+            RECORD(++ recorded_statistics.scanned_member_count;)
+            return C[i][j];
+        },
+        reduced_assignment.data(), reduction_u.data(), reduction_v.data()
+    );
     for (unsigned int i = 0; i < n; ++i)
     {
-        add_to_row(i, /* value: */ -1 * minimum_in_row(i));
+        for (unsigned int j = 0; j < n; ++j)
+        {
+            C[i][j] -= static_cast<unsigned int>(reduction_u[i] + 
+                                                 reduction_v[j]);
+        }
+        u[i]           += reduction_u[i];
+        dual_objective += reduction_u[i];
+    }
+    for (unsigned int j = 0; j < n; ++j)
+    {
+        v[j]           += reduction_v[j];
+        dual_objective += reduction_v[j];
     }
     return Step::Two;
 }
 Problem::Step Problem::step_2()
 {
-    std::vector<bool> is_starred_column(n);
+    detail::HopcroftKarp matching(n);
+    for (unsigned int i = 0; i < n; ++i)
+    {
+        const unsigned int j = reduced_assignment[i];
+        if (j != n) { matching.match(i, j); }
+    }
+    // Greedily matches zeros first, which leaves Hopcroft-Karp few phases.
     for (unsigned int i = 0; i < n; ++i)
     {
+        if (matching.column(i) != matching.none) { continue; }
         for (unsigned int j = 0; j < n; ++j)
         {
-            if  (!is_starred_column[j] && C[i][j] == 0)
+            RECORD(++ recorded_statistics.scanned_member_count;)
+            if (C[i][j] == 0 && matching.row(j) == matching.none)
             {
-                S.insert(i, j)       = true;
-                is_starred_column[j] = true;
-                break;  // Since there is already a starred zero in this row.
+                matching.match(i, j);
+                break;
             }
         }
     }
+    matching.maximize([this](const unsigned int i, const unsigned int j)
+    {
+        RECORD(++ recorded_statistics.scanned_member_count;)
+        return C[i][j] == 0;
+    });
+    for (unsigned int i = 0; i < n; ++i)
+    {
+        const unsigned int j = matching.column(i);
+        if (j != matching.none) { S.insert(i, j) = true; }
+    }
     return Step::Three;
 }
 Problem::Step Problem::step_3()
@@ -121,6 +361,15 @@ Problem::Step Problem::step_5()
         primed_zeroes.push_back(Location(i, j));
     }
     
+    RECORD(
+        const unsigned int length = static_cast<unsigned int>(
+            primed_zeroes.size());
+        recorded_statistics.augmenting_path_length_sum += length;
+        if (length > recorded_statistics.augmenting_path_length_maximum)
+        {
+            recorded_statistics.augmenting_path_length_maximum = length;
+        }
+    )
     for (const auto& location : primed_zeroes) 
     { 
         S.coeffRef(location.first, location.second) = true; 
@@ -142,14 +391,23 @@ Problem::Step Problem::step_5()
 Problem::Step Problem::step_6() 
 {
     const unsigned int m = minimum_uncovered();
+    RECORD(if (m != 0) { ++ recorded_statistics.adjustment_count; })
+    unsigned int covered_row_count = 0, uncovered_column_count = 0;
     for (unsigned int i = 0; i < n; ++i)
     {
-        if (is_covered_row[i]) { add_to_row(i, m); }
+        if (is_covered_row[i]) { add_to_row(i, m); ++ covered_row_count; }
     }
     for (unsigned int j = 0; j < n; ++j)
     {
-        if (!is_covered_column[j]) { add_to_column(j, -1 * m); }
+        if (!is_covered_column[j]) 
+        { 
+            add_to_column(j, -1 * m); 
+            ++ uncovered_column_count; 
+        }
     }
+    // There are fewer than n covering lines, so the dual objective grows.
+    dual_objective += static_cast<unsigned long long>(m) * 
+                      (uncovered_column_count - covered_row_count);
     return Step::Four;
 }
 void Problem::output_solution(unsigned int* assignment) const
@@ -163,15 +421,44 @@ void Problem::output_solution(unsigned int* assignment) const
     }
 }
 
-unsigned int Problem::minimum_in_row(const unsigned int i) const
+unsigned long long Problem::output_greedy_completion(
+    unsigned int* assignment) const
 {
-    unsigned int minimum = C[i][0];
-    for (unsigned int j = 1; j < n; ++j)
+    const unsigned int none = n;
+
+    std::vector<bool> is_assigned_column(n, false);
+    std::fill(assignment, assignment + n, none);
+    for (unsigned int j = 0; j < n; ++j)
     {
-        if (C[i][j] < minimum) { minimum = C[i][j]; }
+        for (ColumnMemberIterator cmi(S, j); cmi; ++cmi)
+        {
+            if (cmi.value()) 
+            { 
+                assignment[cmi.row()] = j; 
+                is_assigned_column[j] = true;
+                break; 
+            }
+        }
     }
-    return minimum;
+    for (unsigned int i = 0; i < n; ++i)
+    {
+        if (assignment[i] != none) { continue; }
+
+        unsigned int cheapest = none;
+        for (unsigned int j = 0; j < n; ++j)
+        {
+            if (is_assigned_column[j]) { continue; }
+            if (cheapest == none || C[i][j] < C[i][cheapest]) { cheapest = j; }
+        }
+        assignment[i]                = cheapest;
+        is_assigned_column[cheapest] = true;
+    }
+
+    unsigned long long cost = 0;
+    for (unsigned int i = 0; i < n; ++i) { cost += C[i][assignment[i]]; }
+    return cost;
 }
+
 unsigned int Problem::minimum_uncovered() const
 {
     unsigned int minimum = std::numeric_limits<unsigned int>::max();
@@ -191,10 +478,12 @@ unsigned int Problem::minimum_uncovered() const
 void Problem::add_to_row(const unsigned int i, const int value)
 {
     for (unsigned int j = 0; j < n; ++j) { C[i][j] += value; }
+    u[i] -= value;
 }
 void Problem::add_to_column(const unsigned int j, const int value)
 {
     for (unsigned int i = 0; i < n; ++i) { C[i][j] += value; }
+    v[j] -= value;
 }
 
 bool Problem::find_uncovered_zero(unsigned int& row_index,
@@ -207,6 +496,7 @@ bool Problem::find_uncovered_zero(unsigned int& row_index,
         {
             if (is_covered_column[j]) { continue; }
 
+            RECORD(++ recorded_statistics.scanned_member_count;)
             if (C[i][j] == 0)
             {
                 row_index    = i;
@@ -0,0 +1,76 @@
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+
+#include "../include/hungarian_algorithm.h"
+#include "../include/inner_product_costs.h"
+
+
+using namespace rharel::hungarian_algorithm;
+
+
+InnerProductCost::InnerProductCost(const unsigned int problem_size,
+                                   const unsigned int dimension,
+                                   const float*       worker_embeddings,
+                                   const float*       task_embeddings,
+                                   const float        scale)
+    : d(dimension), A(worker_embeddings), B(task_embeddings), scale(scale),
+      row_offsets(problem_size)
+{
+    const unsigned int n = problem_size;
+
+    float maximum_B_norm = 0;
+    for (unsigned int j = 0; j < n; ++j)
+    {
+        const float* const b = B + static_cast<std::size_t>(j) * d;
+        float squared_norm = 0;
+        for (unsigned int k = 0; k < d; ++k) { squared_norm += b[k] * b[k]; }
+        maximum_B_norm = std::max(maximum_B_norm, std::sqrt(squared_norm));
+    }
+    for (unsigned int i = 0; i < n; ++i)
+    {
+        const float* const a = A + static_cast<std::size_t>(i) * d;
+        float squared_norm = 0;
+        for (unsigned int k = 0; k < d; ++k) { squared_norm += a[k] * a[k]; }
+        row_offsets[i] = std::sqrt(squared_norm) * maximum_B_norm;
+    }
+}
+unsigned int InnerProductCost::operator()(const unsigned int i, 
+                                          const unsigned int j) const
+{
+    const float* const a = A + static_cast<std::size_t>(i) * d;
+    const float* const b = B + static_cast<std::size_t>(j) * d;
+
+    float inner_product = 0;
+    for (unsigned int k = 0; k < d; ++k) { inner_product += a[k] * b[k]; }
+
+    // The offset bounds the inner product only up to rounding error, so the
+    // difference is clamped.
+    const float maximum = static_cast<float>(
+        std::numeric_limits<unsigned int>::max()
+    );
+    const float cost = scale * (row_offsets[i] - inner_product);
+
+    if (!(cost > 0.0f)) { return 0; }
+    if (cost >= maximum) 
+    { 
+        return std::numeric_limits<unsigned int>::max(); 
+    }
+    return static_cast<unsigned int>(cost + 0.5f);
+}
+
+void rharel::hungarian_algorithm::solve_for_maximum_inner_product_assignment(
+    const unsigned int problem_size,
+    const unsigned int dimension,
+    const float*       worker_embeddings,
+    const float*       task_embeddings,
+    const float        scale,
+    unsigned int*      assignment)
+{
+    const InnerProductCost cost(problem_size, dimension, 
+                                worker_embeddings, task_embeddings, scale);
+    solve_for_minimum_cost_assignment_lazily(problem_size, cost, 
+                                             /* cached_row_count: */ 0,
+                                             assignment);
+}
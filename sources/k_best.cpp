@@ -0,0 +1,509 @@
+#include <algorithm>
+#include <condition_variable>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "../include/hungarian_algorithm.h"
+#include "../include/k_best.h"
+
+
+using namespace rharel::hungarian_algorithm;
+
+
+/// Contains private implementation details.
+namespace rharel::hungarian_algorithm::detail
+{
+    /// An assignment with dual potentials certifying it.
+    struct RankedSolution
+    {
+        std::vector<unsigned int> assignment;
+        std::vector<long long>    u, v;   // Row and column potentials.
+        unsigned long long        cost = 0;
+    };
+    /// A subproblem of Murty's partitioning: the assignments that assign the
+    /// fixed rows as in the solution and avoid the forbidden pairs.
+    struct Subproblem
+    {
+        /// A lower bound on the cost of the subproblem's best assignment, or
+        /// its cost once solved.
+        unsigned long long bound = 0;
+        /// True iff solution is the subproblem's own best assignment.
+        /// Otherwise, it is its parent's, which violates only the last
+        /// forbidden pair.
+        bool is_solved = false;
+        std::shared_ptr<const RankedSolution> solution;
+
+        std::vector<bool> is_fixed_row;
+        std::vector<std::pair<unsigned int, unsigned int>> forbidden_pairs;
+    };
+    /// Orders subproblems by increasing bound; among equal bounds, solved
+    /// ones first.
+    struct SubproblemOrder
+    {
+        bool operator()(const Subproblem& a, const Subproblem& b) const
+        {
+            if (a.bound != b.bound) { return a.bound > b.bound; }
+            return !a.is_solved && b.is_solved;
+        }
+    };
+
+    /// Scratch space of Ranking::solve(), one per thread.
+    struct Workspace
+    {
+        explicit Workspace(const unsigned int n)
+            : distance(n), is_settled(n), previous_row(n), row_of_column(n),
+              is_forbidden_column(n, false)
+        {}
+
+        std::vector<long long>    distance;
+        std::vector<char>         is_settled;
+        std::vector<unsigned int> previous_row;
+        std::vector<unsigned int> row_of_column;
+
+        // The forbidden pairs of the subproblem being solved, by row, and
+        // those of the row being relaxed, by column.
+        std::vector<std::pair<unsigned int, unsigned int>> forbidden_pairs;
+        std::vector<char> is_forbidden_column;
+    };
+
+    /// Ranks assignments of one cost matrix. Its methods only read it, so
+    /// threads may share it, each solving with its own workspace.
+    class Ranking
+    {
+        public:
+        Ranking(const unsigned int                     n,
+                const unsigned int* const* const       C)
+            : n(n), C(C)
+        {}
+
+        /// Finds the best assignment of the unconstrained problem.
+        Subproblem solve_root() const
+        {
+            auto solution = std::make_shared<RankedSolution>();
+            solution->assignment.resize(n);
+            solution->u.resize(n);
+            solution->v.resize(n);
+            solve_by_shortest_augmenting_paths(
+                n,
+                [this](const unsigned int i, const unsigned int j)
+                {
+                    return C[i][j];
+                },
+                solution->assignment.data(), /* tracer: */ nullptr,
+                solution->u.data(), solution->v.data()
+            );
+            solution->cost = cost_of(solution->assignment);
+
+            Subproblem root;
+            root.bound        = solution->cost;
+            root.is_solved    = true;
+            root.solution     = solution;
+            root.is_fixed_row = std::vector<bool>(n, false);
+            return root;
+        }
+        /// Solves an unsolved subproblem from its parent's solution.
+        /// Returns true iff it has a feasible assignment.
+        bool solve(Subproblem& subproblem, Workspace& workspace) const
+        {
+            const RankedSolution& parent = *subproblem.solution;
+            const auto& last_forbidden_pair = subproblem.forbidden_pairs.back();
+            const unsigned int free_row    = last_forbidden_pair.first,
+                               free_column = last_forbidden_pair.second;
+
+            auto solution = std::make_shared<RankedSolution>(parent);
+            workspace.forbidden_pairs = subproblem.forbidden_pairs;
+            std::sort(workspace.forbidden_pairs.begin(),
+                      workspace.forbidden_pairs.end());
+            if (!augment(subproblem.is_fixed_row, free_row, free_column,
+                         *solution, workspace))
+            {
+                return false;
+            }
+
+            solution->cost       = cost_of(solution->assignment);
+            subproblem.bound     = solution->cost;
+            subproblem.is_solved = true;
+            subproblem.solution  = solution;
+            return true;
+        }
+        /// Partitions the remaining assignments of a solved subproblem, and
+        /// adds the parts to the specified queue.
+        template <typename Queue>
+        void partition(const Subproblem& subproblem, Queue& queue) const
+        {
+            const RankedSolution& solution = *subproblem.solution;
+
+            std::vector<unsigned int> free_rows;
+            for (unsigned int i = 0; i < n; ++i)
+            {
+                if (!subproblem.is_fixed_row[i]) { free_rows.push_back(i); }
+            }
+            // Once all other rows are fixed, the last one has no choice.
+            if (free_rows.size() < 2) { return; }
+            free_rows.pop_back();
+
+            std::vector<bool> is_fixed_row = subproblem.is_fixed_row;
+            for (const unsigned int i : free_rows)
+            {
+                const unsigned int j = solution.assignment[i];
+
+                Subproblem part;
+                part.solution        = subproblem.solution;
+                part.is_fixed_row    = is_fixed_row;
+                part.forbidden_pairs = subproblem.forbidden_pairs;
+                part.forbidden_pairs.emplace_back(i, j);
+                part.bound = solution.cost +
+                             least_reduced_cost(part, i, j, solution);
+                queue.push(std::move(part));
+
+                is_fixed_row[i] = true;
+            }
+        }
+
+        private:
+        /// Returns the reduced cost of pair (i, j).
+        long long reduced_cost(const RankedSolution& solution,
+                               const unsigned int    i,
+                               const unsigned int    j) const
+        {
+            return static_cast<long long>(C[i][j]) -
+                   solution.u[i] - solution.v[j];
+        }
+        /// Returns the total cost of an assignment.
+        unsigned long long cost_of(const std::vector<unsigned int>& A) const
+        {
+            unsigned long long cost = 0;
+            for (unsigned int i = 0; i < n; ++i) { cost += C[i][A[i]]; }
+            return cost;
+        }
+        /// Returns a lower bound on the extra cost of the specified part
+        /// over its parent, whose pair (i, j) it forbids. An augmenting path
+        /// leaves row i through one pair and enters column j through
+        /// another, so it is at least as long as the least reduced costs of
+        /// both.
+        ///
+        /// The parent's potentials keep reduced costs non-negative only over
+        /// the pairs its searches could take: forbidden pairs may have
+        /// negative ones, so they are skipped, and each least cost counts as
+        /// at least 0.
+        unsigned long long least_reduced_cost(
+            const Subproblem&     part,
+            const unsigned int    i,
+            const unsigned int    j,
+            const RankedSolution& solution) const
+        {
+            const long long infinity = std::numeric_limits<long long>::max();
+
+            std::vector<char> is_excluded_column(n, 0),
+                              is_excluded_row(n, 0);
+            for (unsigned int r = 0; r < n; ++r)
+            {
+                if (part.is_fixed_row[r])
+                {
+                    is_excluded_column[solution.assignment[r]] = 1;
+                    is_excluded_row[r]                         = 1;
+                }
+            }
+            for (const auto& pair : part.forbidden_pairs)
+            {
+                if (pair.first  == i) { is_excluded_column[pair.second] = 1; }
+                if (pair.second == j) { is_excluded_row[pair.first]     = 1; }
+            }
+            long long least_leaving  = infinity,
+                      least_entering = infinity;
+            for (unsigned int k = 0; k < n; ++k)
+            {
+                if (!is_excluded_column[k])
+                {
+                    least_leaving = std::min(least_leaving,
+                                             reduced_cost(solution, i, k));
+                }
+                if (!is_excluded_row[k])
+                {
+                    least_entering = std::min(least_entering,
+                                              reduced_cost(solution, k, j));
+                }
+            }
+            // With no pair left, the part is infeasible; solving it shows so.
+            if (least_leaving == infinity || least_entering == infinity)
+            {
+                return 0;
+            }
+            return static_cast<unsigned long long>(
+                std::max(0LL, least_leaving) + std::max(0LL, least_entering)
+            );
+        }
+        /// Assigns the free row to a column by the shortest augmenting path
+        /// in reduced costs, ending at the free column, over the rows and
+        /// columns that are not fixed and the pairs that are not forbidden.
+        /// Updates the assignment and potentials of the solution, which must
+        /// be optimal apart from the free row and column.
+        /// Returns true iff there is such a path.
+        bool augment(const std::vector<bool>& is_fixed_row,
+                     const unsigned int       free_row,
+                     const unsigned int       free_column,
+                     RankedSolution&          solution,
+                     Workspace&               workspace) const
+        {
+            const long long    infinity = std::numeric_limits<long long>::max();
+            const unsigned int none     = n;
+
+            std::vector<long long>&    distance      = workspace.distance;
+            std::vector<char>&         is_settled    = workspace.is_settled;
+            std::vector<unsigned int>& previous_row  = workspace.previous_row;
+            std::vector<unsigned int>& row_of_column = workspace.row_of_column;
+            std::vector<char>& is_forbidden_column =
+                workspace.is_forbidden_column;
+            const auto& forbidden_pairs = workspace.forbidden_pairs;
+
+            std::vector<unsigned int>& A = solution.assignment;
+            for (unsigned int i = 0; i < n; ++i) { row_of_column[A[i]] = i; }
+            row_of_column[free_column] = none;
+
+            // Fixed rows keep their columns, so neither takes part.
+            for (unsigned int j = 0; j < n; ++j)
+            {
+                const unsigned int i = row_of_column[j];
+                is_settled[j]   = i != none && is_fixed_row[i];
+                distance[j]     = infinity;
+                previous_row[j] = none;
+            }
+            const auto relax = [&](const unsigned int i, const long long d)
+            {
+                const auto first = std::lower_bound(
+                    forbidden_pairs.begin(), forbidden_pairs.end(),
+                    std::make_pair(i, 0u)
+                );
+                auto last = first;
+                for (; last != forbidden_pairs.end() && last->first == i;
+                     ++last)
+                {
+                    is_forbidden_column[last->second] = true;
+                }
+                for (unsigned int j = 0; j < n; ++j)
+                {
+                    if (is_settled[j] || is_forbidden_column[j]) { continue; }
+
+                    const long long candidate = d + reduced_cost(solution,
+                                                                 i, j);
+                    if (candidate < distance[j])
+                    {
+                        distance[j]     = candidate;
+                        previous_row[j] = i;
+                    }
+                }
+                for (auto pair = first; pair != last; ++pair)
+                {
+                    is_forbidden_column[pair->second] = false;
+                }
+            };
+            std::vector<unsigned int> settled_columns;
+            relax(free_row, 0);
+            while (true)
+            {
+                unsigned int k = none;
+                for (unsigned int j = 0; j < n; ++j)
+                {
+                    if (is_settled[j] || distance[j] == infinity) { continue; }
+                    if (k == none || distance[j] < distance[k]) { k = j; }
+                }
+                if (k == none)        { return false; }
+                if (k == free_column) { break; }
+
+                is_settled[k] = true;
+                settled_columns.push_back(k);
+                relax(row_of_column[k], distance[k]);
+            }
+
+            // Keeps reduced costs non-negative, and zero along the path and
+            // on the other assigned pairs.
+            const long long length = distance[free_column];
+            solution.u[free_row] += length;
+            for (const unsigned int k : settled_columns)
+            {
+                solution.v[k]                   -= length - distance[k];
+                solution.u[row_of_column[k]]    += length - distance[k];
+            }
+
+            // Flips the augmenting path ending at the free column.
+            unsigned int j = free_column;
+            while (true)
+            {
+                const unsigned int i = previous_row[j];
+                const unsigned int next_j = A[i];
+                A[i] = j;
+                if (i == free_row) { break; }
+                j = next_j;
+            }
+            return true;
+        }
+
+        const unsigned int               n;
+        const unsigned int* const* const C;
+    };
+
+    /// Solves batches of subproblems on a fixed set of threads, each with
+    /// its own workspace. The threads are started once, and wait between
+    /// batches; the calling thread solves a share of each batch as well.
+    class BatchSolver
+    {
+        public:
+        BatchSolver(const Ranking&     ranking,
+                    const unsigned int n,
+                    const unsigned int thread_count)
+            : ranking(ranking), workspaces(thread_count, Workspace(n))
+        {
+            for (std::size_t t = 1; t < thread_count; ++t)
+            {
+                threads.emplace_back(&BatchSolver::work, this, t);
+            }
+        }
+        BatchSolver(const BatchSolver&)            = delete;
+        BatchSolver& operator=(const BatchSolver&) = delete;
+        ~BatchSolver()
+        {
+            {
+                const std::lock_guard<std::mutex> lock(mutex);
+                is_stopping = true;
+            }
+            batch_ready.notify_all();
+            for (auto& thread : threads) { thread.join(); }
+        }
+
+        /// Returns the number of threads, and so of subproblems worth
+        /// solving at once.
+        std::size_t size() const { return workspaces.size(); }
+
+        /// Solves the specified subproblems, and sets is_feasible[b] iff
+        /// subproblem b has a feasible assignment.
+        void solve(std::vector<Subproblem>& subproblems,
+                   std::vector<char>&       is_feasible)
+        {
+            is_feasible.assign(subproblems.size(), false);
+            {
+                const std::lock_guard<std::mutex> lock(mutex);
+                batch           = &subproblems;
+                batch_feasible  = &is_feasible;
+                busy_count      = threads.size();
+                ++ batch_number;
+            }
+            batch_ready.notify_all();
+            solve_share(0);
+
+            std::unique_lock<std::mutex> lock(mutex);
+            batch_done.wait(lock, [this]() { return busy_count == 0; });
+        }
+
+        private:
+        /// Solves every size()-th subproblem of the batch, from the t-th.
+        void solve_share(const std::size_t t)
+        {
+            for (std::size_t b = t; b < batch->size(); b += size())
+            {
+                (*batch_feasible)[b] = ranking.solve((*batch)[b],
+                                                     workspaces[t]);
+            }
+        }
+        /// Solves the t-th share of each batch, until stopped.
+        void work(const std::size_t t)
+        {
+            std::size_t last_batch_number = 0;
+            while (true)
+            {
+                {
+                    std::unique_lock<std::mutex> lock(mutex);
+                    batch_ready.wait(lock, [&]()
+                    {
+                        return is_stopping ||
+                               batch_number != last_batch_number;
+                    });
+                    if (is_stopping) { return; }
+                    last_batch_number = batch_number;
+                }
+                solve_share(t);
+
+                const std::lock_guard<std::mutex> lock(mutex);
+                if (-- busy_count == 0) { batch_done.notify_one(); }
+            }
+        }
+
+        const Ranking&           ranking;
+        std::vector<Workspace>   workspaces;
+        std::vector<std::thread> threads;
+
+        std::mutex              mutex;  // Guards the members below.
+        std::condition_variable batch_ready, batch_done;
+        std::vector<Subproblem>* batch          = nullptr;
+        std::vector<char>*       batch_feasible = nullptr;
+        std::size_t              batch_number   = 0;
+        std::size_t              busy_count     = 0;
+        bool                     is_stopping    = false;
+    };
+}
+
+unsigned int rharel::hungarian_algorithm::solve_for_k_best_assignments(
+    const unsigned int               problem_size,
+    const unsigned int* const* const cost_matrix,
+    const unsigned int               k,
+    unsigned int**                   assignments,
+    unsigned long long*              costs,
+    const unsigned int               thread_count)
+{
+    using detail::BatchSolver;
+    using detail::Ranking;
+    using detail::Subproblem;
+    using detail::SubproblemOrder;
+
+    const unsigned int n = problem_size;
+    if (n == 0 || k == 0) { return 0; }
+
+    const Ranking ranking(n, cost_matrix);
+    BatchSolver   solver(ranking, n, std::max(thread_count, 1u));
+
+    std::priority_queue<Subproblem, std::vector<Subproblem>, SubproblemOrder>
+        queue;
+    queue.push(ranking.solve_root());
+
+    std::vector<Subproblem> batch;
+    std::vector<char>       is_feasible;
+
+    unsigned int found_count = 0;
+    while (found_count < k && !queue.empty())
+    {
+        if (!queue.top().is_solved)
+        {
+            // Unsolved subproblems at the front are bounded below by the
+            // solved ones behind them, so solving them in any order keeps
+            // the output ordered.
+            batch.clear();
+            while (batch.size() < solver.size() &&
+                   !queue.empty() && !queue.top().is_solved)
+            {
+                batch.push_back(queue.top());
+                queue.pop();
+            }
+            solver.solve(batch, is_feasible);
+            for (std::size_t b = 0; b < batch.size(); ++b)
+            {
+                if (is_feasible[b]) { queue.push(std::move(batch[b])); }
+            }
+            continue;
+        }
+        Subproblem subproblem = queue.top();
+        queue.pop();
+
+        const auto& assignment = subproblem.solution->assignment;
+        std::copy(assignment.begin(), assignment.end(),
+                  assignments[found_count]);
+        if (costs != nullptr) { costs[found_count] = subproblem.bound; }
+        ++ found_count;
+
+        ranking.partition(subproblem, queue);
+    }
+    return found_count;
+}
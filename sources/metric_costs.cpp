@@ -0,0 +1,255 @@
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <vector>
+
+#include "../include/hungarian_algorithm.h"
+#include "../include/metric_costs.h"
+
+
+using namespace rharel::hungarian_algorithm;
+
+
+/// Contains private implementation details.
+namespace rharel::hungarian_algorithm::detail
+{
+    /// The number of cost matrix rows computed together.
+    constexpr unsigned int kernel_row_count    = 4;
+    /// The number of cost matrix columns computed together.
+    constexpr unsigned int kernel_column_count = 256;
+
+    /// The per-coordinate term of the squared L2 distance.
+    struct SquaredDifference
+    {
+        static float of(const float w, const float t) 
+        { 
+            const float x = w - t; 
+            return x * x; 
+        }
+    };
+    /// The per-coordinate term of the L1 distance.
+    struct AbsoluteDifference
+    {
+        static float of(const float w, const float t) 
+        { 
+            return std::fabs(w - t); 
+        }
+    };
+    /// The per-coordinate term of the inner product.
+    struct Product
+    {
+        static float of(const float w, const float t) { return w * t; }
+    };
+
+    /// Accumulates sum_k Term::of(W(k, i), T(k, j)) for every pair (i, j), 
+    /// and hands the sums to store(i, j0, sums, count) in blocks of 
+    /// consecutive columns j0, ..., j0 + count - 1.
+    ///
+    /// The matrix is computed in tiles of kernel_row_count x 
+    /// kernel_column_count, which stay in L1 cache while all d coordinates 
+    /// are accumulated into them. The innermost loop runs over contiguous 
+    /// task coordinates with a fixed worker coordinate, so it vectorizes.
+    template <typename Term, typename Store>
+    void accumulate_tiles(/* problem size: */ const unsigned int n,
+                          /* dimension:    */ const unsigned int d,
+                          /* workers:      */ const float*       W,
+                          /* tasks:        */ const float*       T,
+                          /* output:       */ const Store&       store)
+    {
+        float tile[kernel_row_count][kernel_column_count];
+
+        for (unsigned int i0 = 0; i0 < n; i0 += kernel_row_count)
+        {
+            const unsigned int row_count = 
+                std::min(kernel_row_count, n - i0);
+            for (unsigned int j0 = 0; j0 < n; j0 += kernel_column_count)
+            {
+                const unsigned int column_count = 
+                    std::min(kernel_column_count, n - j0);
+                for (unsigned int r = 0; r < row_count; ++r)
+                {
+                    std::fill(tile[r], tile[r] + column_count, 0.0f);
+                }
+                for (unsigned int k = 0; k < d; ++k)
+                {
+                    const float* const W_k = W + static_cast<std::size_t>(k) * n;
+                    const float* const T_k = 
+                        T + static_cast<std::size_t>(k) * n + j0;
+                    for (unsigned int r = 0; r < row_count; ++r)
+                    {
+                        const float  w   = W_k[i0 + r];
+                        float* const sum = tile[r];
+                        for (unsigned int j = 0; j < column_count; ++j) 
+                        { 
+                            sum[j] += Term::of(w, T_k[j]); 
+                        }
+                    }
+                }
+                for (unsigned int r = 0; r < row_count; ++r)
+                {
+                    store(i0 + r, j0, tile[r], column_count);
+                }
+            }
+        }
+    }
+
+    /// Computes the squared L2 norm of each of n points.
+    std::vector<float> squared_norms(const unsigned int n,
+                                     const unsigned int d,
+                                     const float*       points)
+    {
+        std::vector<float> norms(n, 0.0f);
+        for (unsigned int k = 0; k < d; ++k)
+        {
+            const float* const x = points + static_cast<std::size_t>(k) * n;
+            for (unsigned int i = 0; i < n; ++i) { norms[i] += x[i] * x[i]; }
+        }
+        return norms;
+    }
+
+    /// Computes all worker-task distances and hands them to 
+    /// store(i, j0, distances, count) in blocks of consecutive columns.
+    template <typename Store>
+    void compute_distances(const Metric       metric,
+                           const unsigned int n,
+                           const unsigned int d,
+                           const float*       W,
+                           const float*       T,
+                           const Store&       store)
+    {
+        switch (metric)
+        {
+            case Metric::Euclidean:
+            {
+                accumulate_tiles<SquaredDifference>(n, d, W, T,
+                    [&store](const unsigned int i, const unsigned int j0,
+                             float* const sums, const unsigned int count)
+                    {
+                        for (unsigned int j = 0; j < count; ++j)
+                        {
+                            sums[j] = std::sqrt(sums[j]);
+                        }
+                        store(i, j0, sums, count);
+                    });
+                break;
+            }
+            case Metric::SquaredEuclidean:
+            {
+                // Summed from coordinate differences rather than expanded
+                // as |w|^2 + |t|^2 - 2<w, t>, whose rounding error grows
+                // with the norms rather than the distance.
+                accumulate_tiles<SquaredDifference>(n, d, W, T, store);
+                break;
+            }
+            case Metric::Manhattan:
+            {
+                accumulate_tiles<AbsoluteDifference>(n, d, W, T, store);
+                break;
+            }
+            case Metric::Cosine:
+            {
+                std::vector<float> W_norms = squared_norms(n, d, W),
+                                   T_norms = squared_norms(n, d, T);
+                for (float& norm : W_norms) { norm = std::sqrt(norm); }
+                for (float& norm : T_norms) { norm = std::sqrt(norm); }
+                accumulate_tiles<Product>(n, d, W, T,
+                    [&](const unsigned int i, const unsigned int j0,
+                        float* const sums, const unsigned int count)
+                    {
+                        for (unsigned int j = 0; j < count; ++j)
+                        {
+                            const float norms = W_norms[i] * T_norms[j0 + j];
+                            sums[j] = norms > 0.0f ? 1.0f - sums[j] / norms 
+                                                   : 1.0f;
+                        }
+                        store(i, j0, sums, count);
+                    });
+                break;
+            }
+        }
+    }
+
+    /// Computes round(scale * distance), saturated to [0, max unsigned].
+    inline unsigned int quantize(const float distance, const float scale)
+    {
+        const float maximum = static_cast<float>(
+            std::numeric_limits<unsigned int>::max()
+        );
+        const float scaled = scale * distance;
+
+        if (!(scaled > 0.0f)) { return 0; }
+        if (scaled >= maximum) 
+        { 
+            return std::numeric_limits<unsigned int>::max(); 
+        }
+        return static_cast<unsigned int>(scaled + 0.5f);
+    }
+}
+
+
+void rharel::hungarian_algorithm::compute_metric_cost_matrix(
+    const Metric       metric,
+    const unsigned int problem_size,
+    const unsigned int dimension,
+    const float*       workers,
+    const float*       tasks,
+    float**            cost_matrix)
+{
+    detail::compute_distances(
+        metric, problem_size, dimension, workers, tasks,
+        [cost_matrix](const unsigned int i, const unsigned int j0,
+                      const float* const distances, const unsigned int count)
+        {
+            std::copy(distances, distances + count, cost_matrix[i] + j0);
+        }
+    );
+}
+void rharel::hungarian_algorithm::compute_metric_cost_matrix(
+    const Metric       metric,
+    const unsigned int problem_size,
+    const unsigned int dimension,
+    const float*       workers,
+    const float*       tasks,
+    const float        scale,
+    unsigned int**     cost_matrix)
+{
+    detail::compute_distances(
+        metric, problem_size, dimension, workers, tasks,
+        [cost_matrix, scale](const unsigned int i, const unsigned int j0,
+                             const float* const distances, 
+                             const unsigned int count)
+        {
+            unsigned int* const costs = cost_matrix[i] + j0;
+            for (unsigned int j = 0; j < count; ++j)
+            {
+                costs[j] = detail::quantize(distances[j], scale);
+            }
+        }
+    );
+}
+void rharel::hungarian_algorithm::solve_for_minimum_metric_cost_assignment(
+    const Metric       metric,
+    const unsigned int problem_size,
+    const unsigned int dimension,
+    const float*       workers,
+    const float*       tasks,
+    const float        scale,
+    unsigned int*      assignment)
+{
+    using std::vector;
+
+    const unsigned int n = problem_size;
+
+    vector<vector<unsigned int>> C(n);
+    vector<unsigned int*>        C_row_pointers(n);
+    for (unsigned int i = 0; i < n; ++i)
+    {
+        C[i].resize(n);
+        C_row_pointers[i] = C[i].data();
+    }
+    unsigned int** C_raw = C_row_pointers.data();
+    compute_metric_cost_matrix(metric, n, dimension, workers, tasks, scale, 
+                               C_raw);
+    solve_for_minimum_cost_assignment(n, C_raw, assignment);
+}
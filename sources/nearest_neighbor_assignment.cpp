@@ -0,0 +1,1126 @@
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <functional>
+#include <limits>
+#include <numeric>
+#include <utility>
+#include <vector>
+
+#include "../include/nearest_neighbor_assignment.h"
+
+
+using namespace rharel::hungarian_algorithm;
+
+
+/// Contains private implementation details.
+namespace rharel::hungarian_algorithm::detail
+{
+    /// A point found by a kd-tree search, with its search distance.
+    struct Neighbor
+    {
+        float        distance;
+        unsigned int position;  // In tree order.
+
+        bool operator<(const Neighbor& other) const
+        {
+            return distance < other.distance;
+        }
+    };
+
+    /// Finds nearest points by L2 or L1 distance.
+    ///
+    /// Points are identified by their position in tree order, where points
+    /// of the same leaf are contiguous, so that arrays indexed by position
+    /// keep nearby points nearby in memory.
+    ///
+    /// Search distances are squared for L2, so that both metrics sum
+    /// per-coordinate terms, and a splitting plane at coordinate difference x
+    /// is x^2 or |x| away.
+    class KdTree
+    {
+        public:
+        /// Builds a tree over n points in d dimensions, given as
+        /// structure-of-arrays.
+        KdTree(const unsigned int n,
+               const unsigned int d,
+               const float* const points,
+               const bool         is_manhattan)
+            : n(n), d(d), is_manhattan(is_manhattan),
+              indices(n), coordinates(static_cast<std::size_t>(n) * d),
+              point_weights(n, 0)
+        {
+            for (unsigned int i = 0; i < n; ++i) { indices[i] = i; }
+            if (n > 0) { build(points, 0, n); }
+            greatest_weights.assign(nodes.size(), 0);
+
+            // Stores coordinates in tree order, so leaves are contiguous.
+            for (unsigned int p = 0; p < n; ++p)
+            {
+                for (unsigned int k = 0; k < d; ++k)
+                {
+                    coordinates[static_cast<std::size_t>(p) * d + k] =
+                        points[static_cast<std::size_t>(k) * n + indices[p]];
+                }
+            }
+        }
+
+        /// Finds the count points nearest to q, in order of increasing
+        /// distance.
+        void find_nearest(const float* const     q,
+                          const unsigned int     count,
+                          std::vector<Neighbor>& nearest) const
+        {
+            nearest.clear();
+            if (n > 0 && count > 0) { search_nearest(q, count, 0, nearest); }
+            std::sort_heap(nearest.begin(), nearest.end());
+        }
+        /// Gets the index of the point at position p.
+        unsigned int index(const unsigned int p) const { return indices[p]; }
+        /// Gets the coordinates of the point at position p.
+        const float* point(const unsigned int p) const
+        {
+            return &coordinates[static_cast<std::size_t>(p) * d];
+        }
+
+        /// Sets the weight of each point, by position.
+        void set_weights(const long long* const weights)
+        {
+            point_weights.assign(weights, weights + n);
+            for (std::size_t k = nodes.size(); k-- > 0;)
+            {
+                const Node& node = nodes[k];
+                long long greatest = std::numeric_limits<long long>::min();
+                if (node.left == none)
+                {
+                    for (unsigned int p = node.begin; p < node.end; ++p)
+                    {
+                        greatest = std::max(greatest, point_weights[p]);
+                    }
+                }
+                else
+                {
+                    // Children follow their parents.
+                    greatest = std::max(greatest_weights[node.left],
+                                        greatest_weights[node.right]);
+                }
+                greatest_weights[k] = greatest;
+            }
+        }
+        /// Finds all points p within search distance radius(weight of p) of
+        /// q, where radius is non-decreasing in the weight.
+        ///
+        /// @tparam Radius
+        ///     The type of a function-like object:
+        ///     float (*)(long long weight);
+        template <typename Radius>
+        void find_within(const float* const     q,
+                         const Radius&          radius,
+                         std::vector<Neighbor>& within) const
+        {
+            within.clear();
+            if (n > 0) { search_within(q, radius, 0, within); }
+        }
+
+        /// Converts a search distance to a distance under the metric.
+        float to_distance(const float search_distance,
+                          const Metric metric) const
+        {
+            return metric == Metric::Euclidean ? std::sqrt(search_distance)
+                                               : search_distance;
+        }
+        /// Converts a distance under the metric to a search distance.
+        float to_search_distance(const float distance,
+                                 const Metric metric) const
+        {
+            return metric == Metric::Euclidean ? distance * distance
+                                               : distance;
+        }
+
+        private:
+        static constexpr unsigned int leaf_size = 16;
+        static constexpr unsigned int none      =
+            std::numeric_limits<unsigned int>::max();
+
+        struct Node
+        {
+            unsigned int begin, end;   // Range of points, in tree order.
+            unsigned int dimension;    // Splitting coordinate.
+            float        split;        // Splitting value.
+            unsigned int left, right;  // Children, or none for leaves.
+        };
+
+        /// Builds the subtree over points [begin, end) in tree order, and
+        /// returns its root.
+        unsigned int build(const float* const points,
+                           const unsigned int begin,
+                           const unsigned int end)
+        {
+            const auto root = static_cast<unsigned int>(nodes.size());
+            nodes.push_back({ begin, end, 0, 0.0f, none, none });
+            if (end - begin <= leaf_size) { return root; }
+
+            // Splits the coordinate of largest spread at its median.
+            unsigned int dimension = 0;
+            float        spread    = -1.0f;
+            for (unsigned int k = 0; k < d; ++k)
+            {
+                const float* const x = points + static_cast<std::size_t>(k) * n;
+                float minimum = x[indices[begin]], maximum = minimum;
+                for (unsigned int p = begin + 1; p < end; ++p)
+                {
+                    minimum = std::min(minimum, x[indices[p]]);
+                    maximum = std::max(maximum, x[indices[p]]);
+                }
+                if (maximum - minimum > spread)
+                {
+                    spread    = maximum - minimum;
+                    dimension = k;
+                }
+            }
+            const float* const x = points +
+                                   static_cast<std::size_t>(dimension) * n;
+            const unsigned int middle = begin + (end - begin) / 2;
+            std::nth_element(indices.begin() + begin,
+                             indices.begin() + middle,
+                             indices.begin() + end,
+                             [x](const unsigned int a, const unsigned int b)
+                             {
+                                 return x[a] < x[b];
+                             });
+
+            nodes[root].dimension = dimension;
+            nodes[root].split     = x[indices[middle]];
+            const unsigned int left  = build(points, begin,  middle);
+            const unsigned int right = build(points, middle, end);
+            nodes[root].left  = left;
+            nodes[root].right = right;
+            return root;
+        }
+
+        /// Gets the search distance between q and the point at position p
+        /// in tree order.
+        float search_distance(const float* const q,
+                              const unsigned int p) const
+        {
+            const float* const x = &coordinates[static_cast<std::size_t>(p) * d];
+            float sum = 0.0f;
+            for (unsigned int k = 0; k < d; ++k)
+            {
+                const float difference = q[k] - x[k];
+                sum += is_manhattan ? std::fabs(difference)
+                                    : difference * difference;
+            }
+            return sum;
+        }
+        /// Gets the search distance of a plane at the specified coordinate
+        /// difference.
+        float plane_distance(const float difference) const
+        {
+            return is_manhattan ? std::fabs(difference)
+                                : difference * difference;
+        }
+
+        void search_nearest(const float* const     q,
+                            const unsigned int     count,
+                            const unsigned int     node_index,
+                            std::vector<Neighbor>& nearest) const
+        {
+            const Node& node = nodes[node_index];
+            if (node.left == none)
+            {
+                for (unsigned int p = node.begin; p < node.end; ++p)
+                {
+                    const Neighbor neighbor = { search_distance(q, p), p };
+                    if (nearest.size() < count)
+                    {
+                        nearest.push_back(neighbor);
+                        std::push_heap(nearest.begin(), nearest.end());
+                    }
+                    else if (neighbor < nearest.front())
+                    {
+                        std::pop_heap(nearest.begin(), nearest.end());
+                        nearest.back() = neighbor;
+                        std::push_heap(nearest.begin(), nearest.end());
+                    }
+                }
+                return;
+            }
+            const float difference = q[node.dimension] - node.split;
+            const unsigned int near = difference < 0.0f ? node.left
+                                                        : node.right,
+                               far  = difference < 0.0f ? node.right
+                                                        : node.left;
+            search_nearest(q, count, near, nearest);
+            if (nearest.size() < count ||
+                plane_distance(difference) <= nearest.front().distance)
+            {
+                search_nearest(q, count, far, nearest);
+            }
+        }
+        template <typename Radius>
+        void search_within(const float* const     q,
+                           const Radius&          radius,
+                           const unsigned int     node_index,
+                           std::vector<Neighbor>& within) const
+        {
+            const Node& node = nodes[node_index];
+            if (node.left == none)
+            {
+                for (unsigned int p = node.begin; p < node.end; ++p)
+                {
+                    const float distance = search_distance(q, p);
+                    if (distance <= radius(point_weights[p]))
+                    {
+                        within.push_back({ distance, p });
+                    }
+                }
+                return;
+            }
+            const float difference = q[node.dimension] - node.split;
+            const unsigned int near = difference < 0.0f ? node.left
+                                                        : node.right,
+                               far  = difference < 0.0f ? node.right
+                                                        : node.left;
+            if (radius(greatest_weights[near]) >= 0.0f)
+            {
+                search_within(q, radius, near, within);
+            }
+            if (plane_distance(difference) <= radius(greatest_weights[far]))
+            {
+                search_within(q, radius, far, within);
+            }
+        }
+
+        const unsigned int n, d;
+        const bool         is_manhattan;
+
+        std::vector<unsigned int> indices;      // Points in tree order.
+        std::vector<float>        coordinates;  // Array-of-structures, in
+                                                // tree order.
+        std::vector<Node>         nodes;
+        std::vector<long long>    point_weights;     // In tree order.
+        std::vector<long long>    greatest_weights;  // Per node.
+    };
+
+    /// A candidate pair of a row.
+    struct Edge
+    {
+        unsigned int column;
+        long long    cost;
+    };
+
+    /// Solves the assignment problem over a sparse set of candidate pairs
+    /// by successive shortest augmenting paths, as a Dijkstra search over
+    /// reduced costs with a binary heap.
+    ///
+    /// Keeps potentials u, v with c(i, j) - u(i) - v(j) >= 0 over all
+    /// candidate pairs, and equality on assigned ones. Candidates may be
+    /// added at any time; a row whose new candidates violate that is
+    /// unassigned, to be augmented again.
+    class SparseAssignment
+    {
+        public:
+        static constexpr unsigned int none =
+            std::numeric_limits<unsigned int>::max();
+
+        explicit SparseAssignment(const unsigned int n)
+            : n(n), edges(n), u(n, 0), v(n, 0),
+              column_of_row(n, none), row_of_column(n, none),
+              distance(n, infinity), is_settled(n, false),
+              previous_row(n, none)
+        {}
+
+        /// Adds a candidate pair.
+        void add_edge(const unsigned int i, const unsigned int j,
+                      const long long cost)
+        {
+            edges[i].push_back({ j, cost });
+            if (cost - u[i] - v[j] >= 0) { return; }
+
+            // Lowers u(i) to its least reduced cost, which leaves the
+            // assigned pair, if any, with a positive one.
+            u[i] = cost - v[j];
+            if (column_of_row[i] != none)
+            {
+                row_of_column[column_of_row[i]] = none;
+                column_of_row[i]                = none;
+            }
+        }
+        /// Assigns rows and sets potentials by the column reduction,
+        /// reduction transfer and augmenting row reduction of
+        /// initialize_by_reduction(), over candidate pairs only.
+        void initialize()
+        {
+            // Column reduction. Columns of no candidates keep v = 0, which
+            // no cost is below.
+            std::vector<unsigned int> row_of_minimum(n, none);
+            for (unsigned int i = 0; i < n; ++i)
+            {
+                for (const Edge& edge : edges[i])
+                {
+                    const unsigned int j = edge.column;
+                    if (row_of_minimum[j] == none || edge.cost < v[j])
+                    {
+                        v[j]              = edge.cost;
+                        row_of_minimum[j] = i;
+                    }
+                }
+            }
+            std::vector<unsigned int> column_count(n, 0);
+            for (unsigned int j = n; j-- > 0;)
+            {
+                const unsigned int i = row_of_minimum[j];
+                if (i != none && column_count[i]++ == 0)
+                {
+                    column_of_row[i] = j;
+                    row_of_column[j] = i;
+                }
+            }
+
+            // Reduction transfer.
+            std::vector<unsigned int> free_rows;
+            for (unsigned int i = 0; i < n; ++i)
+            {
+                if (column_count[i] == 0) { free_rows.push_back(i); continue; }
+                if (column_count[i] > 1) { continue; }
+
+                const unsigned int j1      = column_of_row[i];
+                long long          minimum = infinity;
+                for (const Edge& edge : edges[i])
+                {
+                    if (edge.column == j1) { continue; }
+                    minimum = std::min(minimum, edge.cost - v[edge.column]);
+                }
+                if (minimum != infinity) { v[j1] -= minimum; }
+            }
+
+            reduce_rows(free_rows);
+        }
+        /// Assigns rows and sets potentials by the augmenting row reduction
+        /// of initialize(), from the specified column potentials, such as
+        /// those of a similar problem, with all rows unassigned.
+        void initialize(const long long* const column_potentials)
+        {
+            v.assign(column_potentials, column_potentials + n);
+            std::vector<unsigned int> free_rows(n);
+            for (unsigned int i = 0; i < n; ++i) { free_rows[i] = i; }
+            reduce_rows(free_rows);
+        }
+
+        /// Assigns row r, which must be unassigned, along the shortest
+        /// augmenting path in reduced costs, and updates potentials.
+        /// Returns true iff there is one. Otherwise, the columns the search
+        /// settled remain in settled(); they are all assigned, to rows the
+        /// search reached.
+        bool augment(const unsigned int r)
+        {
+            for (const unsigned int j : touched_columns)
+            {
+                distance[j]   = infinity;
+                is_settled[j] = false;
+            }
+            touched_columns.clear();
+            settled_columns.clear();
+            heap.clear();
+
+            const auto relax = [&](const unsigned int i, const long long d)
+            {
+                for (const Edge& edge : edges[i])
+                {
+                    const unsigned int j = edge.column;
+                    if (is_settled[j]) { continue; }
+
+                    const long long candidate = d + edge.cost - u[i] - v[j];
+                    if (candidate < distance[j])
+                    {
+                        if (distance[j] == infinity)
+                        {
+                            touched_columns.push_back(j);
+                        }
+                        distance[j]     = candidate;
+                        previous_row[j] = i;
+                        heap.push_back({ candidate, j });
+                        std::push_heap(heap.begin(), heap.end(), later);
+                    }
+                }
+            };
+            relax(r, 0);
+
+            unsigned int free_column = none;
+            while (!heap.empty())
+            {
+                std::pop_heap(heap.begin(), heap.end(), later);
+                const Entry top = heap.back();
+                heap.pop_back();
+                const unsigned int j = top.second;
+                if (is_settled[j] || top.first != distance[j]) { continue; }
+
+                if (row_of_column[j] == none) { free_column = j; break; }
+
+                is_settled[j] = true;
+                settled_columns.push_back(j);
+                relax(row_of_column[j], distance[j]);
+            }
+            if (free_column == none) { return false; }
+
+            // Keeps reduced costs non-negative, and zero along the path and
+            // on the other assigned pairs.
+            const long long length = distance[free_column];
+            u[r] += length;
+            for (const unsigned int k : settled_columns)
+            {
+                v[k]                -= length - distance[k];
+                u[row_of_column[k]] += length - distance[k];
+            }
+
+            unsigned int j = free_column;
+            while (true)
+            {
+                const unsigned int i      = previous_row[j];
+                const unsigned int next_j = column_of_row[i];
+                column_of_row[i] = j;
+                row_of_column[j] = i;
+                if (i == r) { break; }
+                j = next_j;
+            }
+            return true;
+        }
+
+        /// Gets the columns settled by the last call to augment().
+        const std::vector<unsigned int>& settled() const
+        {
+            return settled_columns;
+        }
+        /// Gets the candidate pairs of row i.
+        const std::vector<Edge>& row_edges(const unsigned int i) const
+        {
+            return edges[i];
+        }
+        /// Gets the column assigned to row i, or none.
+        unsigned int column(const unsigned int i) const
+        {
+            return column_of_row[i];
+        }
+        /// Gets the potential of row i.
+        long long row_potential(const unsigned int i) const { return u[i]; }
+        /// Gets the potential of column j.
+        long long column_potential(const unsigned int j) const
+        {
+            return v[j];
+        }
+
+        private:
+        static constexpr long long infinity =
+            std::numeric_limits<long long>::max();
+
+        /// Assigns the specified unassigned rows by two passes of augmenting
+        /// row reduction, then sets each u(i) to its least reduced cost.
+        void reduce_rows(std::vector<unsigned int>& free_rows)
+        {
+            // Augmenting row reduction. A row of a single candidate takes it
+            // without lowering its potential. Unlike over all pairs, rows
+            // whose candidates are too few to assign them all would displace
+            // each other forever, so displaced rows wait for the next pass.
+            for (unsigned int pass = 0; pass < 2; ++pass)
+            {
+                std::size_t next_free_row_count = 0;
+                for (std::size_t k = 0; k < free_rows.size(); ++k)
+                {
+                    const unsigned int i = free_rows[k];
+
+                    long long    least = infinity, second = infinity;
+                    unsigned int j1 = none, j2 = none;
+                    for (const Edge& edge : edges[i])
+                    {
+                        const long long h = edge.cost - v[edge.column];
+                        if (h >= second) { continue; }
+                        if (h >= least) { second = h; j2 = edge.column; }
+                        else
+                        {
+                            second = least; j2 = j1;
+                            least  = h;     j1 = edge.column;
+                        }
+                    }
+
+                    const bool is_lowered = least < second &&
+                                            second != infinity;
+                    unsigned int i0 = row_of_column[j1];
+                    if (is_lowered) { v[j1] -= second - least; }
+                    else if (i0 != none && j2 != none)
+                    {
+                        j1 = j2; i0 = row_of_column[j2];
+                    }
+
+                    if (i0 != none) { column_of_row[i0] = none; }
+                    column_of_row[i]  = j1;
+                    row_of_column[j1] = i;
+
+                    if (i0 != none) { free_rows[next_free_row_count++] = i0; }
+                }
+                free_rows.resize(next_free_row_count);
+            }
+
+            for (unsigned int i = 0; i < n; ++i)
+            {
+                u[i] = infinity;
+                for (const Edge& edge : edges[i])
+                {
+                    u[i] = std::min(u[i], edge.cost - v[edge.column]);
+                }
+            }
+        }
+
+        /// A column reached at a tentative distance.
+        using Entry = std::pair<long long, unsigned int>;
+        static constexpr std::greater<Entry> later{};
+
+        const unsigned int n;
+
+        std::vector<std::vector<Edge>> edges;
+        std::vector<long long>         u, v;
+        std::vector<unsigned int>      column_of_row, row_of_column;
+
+        // Scratch space of augment().
+        std::vector<long long>    distance;
+        std::vector<bool>         is_settled;
+        std::vector<unsigned int> previous_row;
+        std::vector<unsigned int> touched_columns, settled_columns;
+        std::vector<Entry>        heap;  // Ordered by std::push_heap().
+    };
+
+    /// Computes the distance between worker i and task j exactly as
+    /// compute_metric_cost_matrix() does, so that quantized costs agree.
+    class PairDistance
+    {
+        public:
+        PairDistance(const Metric       metric,
+                     const unsigned int n,
+                     const unsigned int d,
+                     const float* const W,
+                     const float* const T)
+            : metric(metric), n(n), d(d), W(W), T(T)
+        {
+            if (metric != Metric::Cosine) { return; }
+            W_norms.assign(n, 0.0f);
+            T_norms.assign(n, 0.0f);
+            for (unsigned int k = 0; k < d; ++k)
+            {
+                const float* const w = W + static_cast<std::size_t>(k) * n;
+                const float* const t = T + static_cast<std::size_t>(k) * n;
+                for (unsigned int i = 0; i < n; ++i)
+                {
+                    W_norms[i] += w[i] * w[i];
+                    T_norms[i] += t[i] * t[i];
+                }
+            }
+            for (float& norm : W_norms) { norm = std::sqrt(norm); }
+            for (float& norm : T_norms) { norm = std::sqrt(norm); }
+        }
+
+        float operator()(const unsigned int i, const unsigned int j) const
+        {
+            float sum = 0.0f;
+            for (unsigned int k = 0; k < d; ++k)
+            {
+                const float w = W[static_cast<std::size_t>(k) * n + i],
+                            t = T[static_cast<std::size_t>(k) * n + j];
+                switch (metric)
+                {
+                    case Metric::Euclidean:
+                    case Metric::SquaredEuclidean:
+                    {
+                        const float x = w - t;
+                        sum += x * x;
+                        break;
+                    }
+                    case Metric::Manhattan: { sum += std::fabs(w - t); break; }
+                    default:                { sum += w * t;            break; }
+                }
+            }
+            switch (metric)
+            {
+                case Metric::Euclidean: { return std::sqrt(sum); }
+                case Metric::Cosine:
+                {
+                    const float norms = W_norms[i] * T_norms[j];
+                    return norms > 0.0f ? 1.0f - sum / norms : 1.0f;
+                }
+                default: { return sum; }
+            }
+        }
+
+        private:
+        const Metric       metric;
+        const unsigned int n, d;
+        const float* const W;
+        const float* const T;
+        std::vector<float> W_norms, T_norms;
+    };
+
+    /// Computes round(scale * distance), saturated to [0, max unsigned], as
+    /// compute_metric_cost_matrix() does.
+    inline long long quantize_distance(const float distance,
+                                       const float scale)
+    {
+        const float maximum = static_cast<float>(
+            std::numeric_limits<unsigned int>::max()
+        );
+        const float scaled = scale * distance;
+
+        if (!(scaled > 0.0f)) { return 0; }
+        if (scaled >= maximum)
+        {
+            return std::numeric_limits<unsigned int>::max();
+        }
+        return static_cast<unsigned int>(scaled + 0.5f);
+    }
+
+
+    /// Solves the assignment problem between points over candidate pairs of
+    /// nearby workers and tasks, found with kd-trees.
+    ///
+    /// Rows and columns are numbered by position in the trees of workers and
+    /// tasks, so that searches over nearby points stay nearby in memory.
+    class CandidateAssignment
+    {
+        public:
+        /// Makes each worker's count nearest tasks and each task's count
+        /// nearest workers candidates, so that no task is left without
+        /// candidates.
+        CandidateAssignment(const Metric       metric,
+                            const unsigned int n,
+                            const unsigned int d,
+                            const float* const W,
+                            const float* const T,
+                            const float        scale,
+                            const unsigned int count)
+            : metric(metric), n(n), d(d), scale(scale),
+              initial_count(std::min(std::max(count, 1u), n)),
+              worker_tree(n, d, W, metric == Metric::Manhattan),
+              task_tree(n, d, T, metric == Metric::Manhattan),
+              pair_distance(metric, n, d, W, T),
+              problem(n), is_candidate(n, false), least_pruned_cost(n, 0)
+        {
+            std::vector<std::vector<unsigned int>> nearest_to_task(n);
+            for (unsigned int j = 0; j < n; ++j)
+            {
+                worker_tree.find_nearest(task_tree.point(j), initial_count,
+                                         neighbors);
+                for (const Neighbor& neighbor : neighbors)
+                {
+                    nearest_to_task[neighbor.position].push_back(j);
+                }
+            }
+            for (unsigned int i = 0; i < n; ++i)
+            {
+                find_nearest(i, initial_count);
+                for (const unsigned int j : nearest_to_task[i])
+                {
+                    neighbors.push_back({ 0.0f, j });
+                }
+                std::vector<unsigned int>().swap(nearest_to_task[i]);
+                add_candidates(i);
+            }
+        }
+
+        /// Assigns rows over the candidates so far by
+        /// SparseAssignment::initialize(), and augments the others.
+        void solve()
+        {
+            problem.initialize();
+            augment_all();
+        }
+        /// Assigns all rows by coarsening, solving coarsely and refining.
+        ///
+        /// The coarser problem merges each two workers, and each two tasks,
+        /// adjacent in tree order at their centroid, and is solved likewise,
+        /// down to smallest_level_size. Each row then takes the tasks merged
+        /// into the coarse task its own was assigned as candidates, and each
+        /// column the potential of its coarse column, which accounts for
+        /// the imbalance of workers and tasks at coarser scales. From there,
+        /// rows are assigned by augmenting row reduction, and the paths left
+        /// to augment are short.
+        void solve_by_levels()
+        {
+            constexpr unsigned int smallest_level_size = 1024;
+
+            const unsigned int m = n / 2;
+            if (m < smallest_level_size) { solve(); return; }
+
+            std::vector<unsigned int> coarse_assignment(m);
+            std::vector<long long>    coarse_potentials(m);
+            {
+                std::vector<float> W(static_cast<std::size_t>(m) * d),
+                                   T(static_cast<std::size_t>(m) * d);
+                for (unsigned int k = 0; k < d; ++k)
+                {
+                    for (unsigned int a = 0; a < m; ++a)
+                    {
+                        const std::size_t x = static_cast<std::size_t>(k) * m
+                                              + a;
+                        W[x] = (worker_tree.point(2 * a)[k] +
+                                worker_tree.point(2 * a + 1)[k]) / 2;
+                        T[x] = (task_tree.point(2 * a)[k] +
+                                task_tree.point(2 * a + 1)[k]) / 2;
+                    }
+                }
+                CandidateAssignment coarse(metric, m, d, W.data(), T.data(),
+                                           scale, initial_count);
+                coarse.solve_by_levels();
+                coarse.output_assignment(coarse_assignment.data());
+                coarse.output_column_potentials(coarse_potentials.data());
+            }
+
+            // With n odd, the last worker and task are merged into none, so
+            // they take each other, and the potential of their neighbors.
+            std::vector<long long> v(n);
+            for (unsigned int i = 0; i < n; ++i)
+            {
+                const unsigned int a = std::min(i / 2, m - 1);
+                const unsigned int b = coarse_assignment[a];
+                neighbors.clear();
+                if (i < 2 * m)
+                {
+                    neighbors.push_back({ 0.0f, 2 * b });
+                    neighbors.push_back({ 0.0f, 2 * b + 1 });
+                }
+                else { neighbors.push_back({ 0.0f, i }); }
+                add_candidates(i);
+
+                v[i] = coarse_potentials[a];
+            }
+            problem.initialize(v.data());
+            augment_all();
+        }
+
+        /// Augments unassigned rows. If row r has no augmenting path, the
+        /// search settled a set of columns all assigned to the rows it
+        /// reached, so r takes some of its nearest tasks outside that set,
+        /// twice as many on each retry. Those are not its nearest overall,
+        /// so its bound on pruned costs stays as it was. r is unassigned, so
+        /// that cannot unassign others.
+        void augment_all()
+        {
+            std::vector<bool> is_settled(n, false);
+            for (unsigned int r = 0; r < n; ++r)
+            {
+                for (unsigned int escape_count = initial_count;
+                     problem.column(r) == SparseAssignment::none &&
+                     !problem.augment(r);
+                     escape_count = std::min(2 * escape_count, n))
+                {
+                    const std::vector<unsigned int>& settled =
+                        problem.settled();
+                    const unsigned int count = std::min(
+                        static_cast<unsigned int>(settled.size()) +
+                        escape_count,
+                        n
+                    );
+                    for (const unsigned int j : settled)
+                    {
+                        is_settled[j] = true;
+                    }
+                    task_tree.find_nearest(worker_tree.point(r), count,
+                                           neighbors);
+                    neighbors.erase(
+                        std::remove_if(neighbors.begin(), neighbors.end(),
+                                       [&](const Neighbor& neighbor)
+                                       {
+                                           return is_settled[
+                                               neighbor.position
+                                           ];
+                                       }),
+                        neighbors.end()
+                    );
+                    neighbors.resize(std::min<std::size_t>(neighbors.size(),
+                                                           escape_count));
+                    for (const unsigned int j : settled)
+                    {
+                        is_settled[j] = false;
+                    }
+                    add_candidates(r);
+                }
+            }
+        }
+
+        /// Finds pruned pairs with negative reduced costs, the most negative
+        /// of each row only, as many as it started with, for
+        /// add_improving_candidates().
+        ///
+        /// Returns a lower bound on the cost of an optimal assignment for the
+        /// full problem. That is, the dual objective of the potentials with
+        /// each u(i) lowered to the least C(i, j) - v(j) over all tasks, so
+        /// that they are feasible for all pairs rather than candidates only.
+        long long find_improving_candidates()
+        {
+            std::vector<long long> v(n);
+            for (unsigned int j = 0; j < n; ++j)
+            {
+                v[j] = problem.column_potential(j);
+            }
+            task_tree.set_weights(v.data());
+            const long long greatest_v = *std::max_element(v.begin(), v.end());
+
+            improving.clear();
+            long long lower_bound = std::accumulate(v.begin(), v.end(), 0LL);
+            for (unsigned int i = 0; i < n; ++i)
+            {
+                // A pruned pair (i, j) improves the assignment only if
+                // C(i, j) < u(i) + v(j) <= u(i) + greatest_v.
+                const long long u_i = problem.row_potential(i);
+                lower_bound += u_i;
+                if (u_i + greatest_v <= least_pruned_cost[i]) { continue; }
+
+                // Allows for rounding in distances computed two ways, as in
+                // find_nearest().
+                const auto radius = [&](const long long v_j)
+                {
+                    const long long threshold = u_i + v_j;
+                    if (threshold < 0) { return -1.0f; }
+                    return task_tree.to_search_distance(
+                        (static_cast<float>(threshold) + 1.0f) / scale *
+                        (1.0f + 1e-5f),
+                        metric
+                    );
+                };
+                task_tree.find_within(worker_tree.point(i), radius, neighbors);
+
+                violations.clear();
+                for (const Neighbor& neighbor : neighbors)
+                {
+                    const unsigned int j = neighbor.position;
+                    const long long    h = cost(i, j) - u_i - v[j];
+                    if (h < 0) { violations.push_back({ h, j }); }
+                }
+                if (violations.empty()) { continue; }
+                if (violations.size() > initial_count)
+                {
+                    std::nth_element(violations.begin(),
+                                     violations.begin() + initial_count,
+                                     violations.end());
+                    violations.resize(initial_count);
+                }
+                long long least = 0;
+                for (const auto& violation : violations)
+                {
+                    least = std::min(least, violation.first);
+                    improving.push_back({ i, violation.second });
+                }
+                lower_bound += least;
+            }
+            return lower_bound;
+        }
+        /// Adds the pairs found by find_improving_candidates(), which leaves
+        /// their rows to be augmented again.
+        /// Returns true iff there are any; otherwise, the assignment is
+        /// optimal for the full problem.
+        bool add_improving_candidates()
+        {
+            for (std::size_t k = 0; k < improving.size();)
+            {
+                const unsigned int i = improving[k].first;
+                neighbors.clear();
+                for (; k < improving.size() && improving[k].first == i; ++k)
+                {
+                    neighbors.push_back({ 0.0f, improving[k].second });
+                }
+                add_candidates(i);
+            }
+            return !improving.empty();
+        }
+
+        /// Returns the cost of the assignment.
+        unsigned long long assignment_cost() const
+        {
+            unsigned long long sum = 0;
+            for (unsigned int i = 0; i < n; ++i)
+            {
+                sum += cost(i, problem.column(i));
+            }
+            return sum;
+        }
+        /// Writes the assignment, by index, onto the specified output buffer.
+        void output_assignment(unsigned int* const A) const
+        {
+            for (unsigned int i = 0; i < n; ++i)
+            {
+                A[worker_tree.index(i)] = task_tree.index(problem.column(i));
+            }
+        }
+        /// Writes the column potentials, by index, onto the specified output
+        /// buffer.
+        void output_column_potentials(long long* const v) const
+        {
+            for (unsigned int j = 0; j < n; ++j)
+            {
+                v[task_tree.index(j)] = problem.column_potential(j);
+            }
+        }
+
+        private:
+        /// Gets the cost of row i and column j.
+        long long cost(const unsigned int i, const unsigned int j) const
+        {
+            return quantize_distance(
+                pair_distance(worker_tree.index(i), task_tree.index(j)), scale
+            );
+        }
+
+        /// Adds the tasks of the current neighbors that are not candidates
+        /// of row i yet.
+        void add_candidates(const unsigned int i)
+        {
+            for (const Edge& edge : problem.row_edges(i))
+            {
+                is_candidate[edge.column] = true;
+            }
+            for (const Neighbor& neighbor : neighbors)
+            {
+                const unsigned int j = neighbor.position;
+                if (is_candidate[j]) { continue; }
+                is_candidate[j] = true;
+                problem.add_edge(i, j, cost(i, j));
+            }
+            for (const Edge& edge : problem.row_edges(i))
+            {
+                is_candidate[edge.column] = false;
+            }
+        }
+        /// Finds the nearest count tasks of row i, and bounds the cost of the
+        /// others.
+        void find_nearest(const unsigned int i, const unsigned int count)
+        {
+            task_tree.find_nearest(worker_tree.point(i), count, neighbors);
+            least_pruned_cost[i] = unbounded;
+            if (count < n)
+            {
+                // Allows for rounding in distances computed two ways.
+                const float distance = task_tree.to_distance(
+                    neighbors.back().distance, metric
+                );
+                least_pruned_cost[i] =
+                    quantize_distance(distance * (1.0f - 1e-5f), scale) - 1;
+            }
+        }
+
+        static constexpr long long unbounded =
+            std::numeric_limits<long long>::max();
+
+        const Metric       metric;
+        const unsigned int n, d;
+        const float        scale;
+        const unsigned int initial_count;
+
+        const KdTree       worker_tree;
+        KdTree             task_tree;
+        const PairDistance pair_distance;
+        SparseAssignment   problem;
+
+        std::vector<Neighbor>     neighbors;
+        std::vector<bool>         is_candidate;
+        // Every pruned task of row i is at least least_pruned_cost[i] away.
+        std::vector<long long>    least_pruned_cost;
+
+        // Scratch space of find_improving_candidates().
+        std::vector<std::pair<long long, unsigned int>>    violations;
+        std::vector<std::pair<unsigned int, unsigned int>> improving;
+    };
+}
+
+void rharel::hungarian_algorithm::
+solve_for_minimum_metric_cost_assignment_sparsely(
+    const Metric       metric,
+    const unsigned int problem_size,
+    const unsigned int dimension,
+    const float*       workers,
+    const float*       tasks,
+    const float        scale,
+    const unsigned int candidate_count,
+    unsigned int*      assignment)
+{
+    using detail::CandidateAssignment;
+
+    const unsigned int n = problem_size;
+    const unsigned int d = dimension;
+    if (n == 0) { return; }
+    if (metric == Metric::Cosine)
+    {
+        solve_for_minimum_metric_cost_assignment(metric, n, d, workers, tasks,
+                                                 scale, assignment);
+        return;
+    }
+
+    CandidateAssignment problem(metric, n, d, workers, tasks, scale,
+                                candidate_count);
+    problem.solve();
+
+    // Adds pruned pairs with negative reduced costs, if any, and solves
+    // again.
+    problem.find_improving_candidates();
+    while (problem.add_improving_candidates())
+    {
+        problem.augment_all();
+        problem.find_improving_candidates();
+    }
+    problem.output_assignment(assignment);
+}
+
+CostBounds rharel::hungarian_algorithm::
+solve_for_metric_cost_assignment_by_levels(
+    const Metric       metric,
+    const unsigned int problem_size,
+    const unsigned int dimension,
+    const float*       workers,
+    const float*       tasks,
+    const float        scale,
+    const unsigned int candidate_count,
+    const double       relative_gap_tolerance,
+    unsigned int*      assignment)
+{
+    using detail::CandidateAssignment;
+    using detail::PairDistance;
+    using detail::quantize_distance;
+
+    const unsigned int n = problem_size;
+    const unsigned int d = dimension;
+    if (n == 0) { return { 0, 0 }; }
+
+    const PairDistance pair_distance(metric, n, d, workers, tasks);
+    const auto cost = [&](const unsigned int i, const unsigned int j)
+    {
+        return quantize_distance(pair_distance(i, j), scale);
+    };
+    if (metric == Metric::Cosine)
+    {
+        solve_for_minimum_metric_cost_assignment(metric, n, d, workers, tasks,
+                                                 scale, assignment);
+        unsigned long long sum = 0;
+        for (unsigned int i = 0; i < n; ++i) { sum += cost(i, assignment[i]); }
+        return { sum, sum };
+    }
+
+    CandidateAssignment problem(metric, n, d, workers, tasks, scale,
+                                candidate_count);
+    problem.solve_by_levels();
+
+    // Adds pruned pairs with negative reduced costs, and solves again, until
+    // the bounds are close enough.
+    CostBounds bounds;
+    while (true)
+    {
+        bounds.lower = static_cast<unsigned long long>(
+            std::max(problem.find_improving_candidates(), 0LL)
+        );
+        bounds.upper = problem.assignment_cost();
+        if (bounds.upper - bounds.lower <=
+                relative_gap_tolerance * bounds.upper ||
+            !problem.add_improving_candidates())
+        {
+            break;
+        }
+        problem.augment_all();
+    }
+    problem.output_assignment(assignment);
+    return bounds;
+}
@@ -0,0 +1,92 @@
+#include <algorithm>
+#include <vector>
+
+#include "../include/sensitivity.h"
+
+
+using namespace rharel::hungarian_algorithm;
+
+
+void rharel::hungarian_algorithm::compute_cost_tolerances(
+    const unsigned int               problem_size,
+    const unsigned int* const* const cost_matrix,
+    const unsigned int*              assignment,
+    const long long*                 row_potentials,
+    const long long*                 column_potentials,
+    unsigned long long**             tolerances)
+{
+    using std::vector;
+
+    const unsigned int n = problem_size;
+    const unsigned int* const* const C = cost_matrix;
+    const unsigned int* const        A = assignment;
+    const long long* const           u = row_potentials;
+    const long long* const           v = column_potentials;
+
+    const auto reduced_cost = [C, u, v](const unsigned int i,
+                                        const unsigned int j)
+    {
+        return static_cast<long long>(C[i][j]) - u[i] - v[j];
+    };
+
+    vector<unsigned int> row_of_column(n);
+    for (unsigned int i = 0; i < n; ++i) { row_of_column[A[i]] = i; }
+
+    vector<long long> distance(n);
+    vector<bool>      is_settled(n);
+    for (unsigned int r = 0; r < n; ++r)
+    {
+        // Finds the shortest alternating paths from row r to every column:
+        // each path leaves a row through an unassigned pair and enters the
+        // next row through the column assigned to it.
+        std::fill(is_settled.begin(), is_settled.end(), false);
+        is_settled[A[r]] = true;  // Leads back to r.
+        for (unsigned int k = 0; k < n; ++k) 
+        { 
+            distance[k] = reduced_cost(r, k); 
+        }
+
+        for (unsigned int settled_count = 1; settled_count < n;
+             ++ settled_count)
+        {
+            unsigned int k = n;
+            for (unsigned int l = 0; l < n; ++l)
+            {
+                if (!is_settled[l] && (k == n || distance[l] < distance[k]))
+                {
+                    k = l;
+                }
+            }
+            is_settled[k] = true;
+
+            const unsigned int q = row_of_column[k];
+            for (unsigned int l = 0; l < n; ++l)
+            {
+                if (is_settled[l]) { continue; }
+                distance[l] = std::min(distance[l],
+                                       distance[k] + reduced_cost(q, l));
+            }
+        }
+
+        // Assigning worker i to task j = A[r] displaces row r, which must
+        // then reach the column i leaves, A[i].
+        const unsigned int j = A[r];
+        for (unsigned int i = 0; i < n; ++i)
+        {
+            if (i == r) { continue; }
+            tolerances[i][j] = static_cast<unsigned long long>(
+                reduced_cost(i, j) + distance[A[i]]);
+        }
+    }
+
+    for (unsigned int i = 0; i < n; ++i)
+    {
+        unsigned long long tolerance = unlimited_cost_change;
+        for (unsigned int j = 0; j < n; ++j)
+        {
+            if (j == A[i]) { continue; }
+            tolerance = std::min(tolerance, tolerances[i][j]);
+        }
+        tolerances[i][A[i]] = tolerance;
+    }
+}
@@ -0,0 +1,31 @@
+#include <vector>
+
+#include "../include/hungarian_algorithm.h"
+#include "../include/submatrix_view.h"
+
+
+using namespace rharel::hungarian_algorithm;
+
+
+unsigned long long rharel::hungarian_algorithm::
+solve_for_minimum_cost_assignment(
+    const SubmatrixView& view,
+    unsigned int*        assignment)
+{
+    using detail::solve_by_shortest_augmenting_paths;
+
+    const unsigned int n = view.size();
+    if (n == 0) { return 0; }
+
+    std::vector<unsigned int> local_assignment(n);
+    solve_by_shortest_augmenting_paths(n, view, local_assignment.data());
+
+    unsigned long long cost = 0;
+    for (unsigned int a = 0; a < n; ++a)
+    {
+        const unsigned int b = local_assignment[a];
+        assignment[view.row(a)] = view.column(b);
+        cost += view(a, b);
+    }
+    return cost;
+}
@@ -0,0 +1,92 @@
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+
+#include "../include/tracer.h"
+
+
+using namespace rharel::hungarian_algorithm;
+
+
+Tracer::Tracer() : start_time(std::chrono::steady_clock::now()) {}
+
+void Tracer::begin(const char* const name, const char* const category)
+{
+    record(name, category);
+}
+void Tracer::end()
+{
+    record(nullptr, nullptr);
+}
+void Tracer::record(const char* const name, const char* const category)
+{
+    const auto now = std::chrono::steady_clock::now();
+    const std::thread::id thread = std::this_thread::get_id();
+
+    const std::lock_guard<std::mutex> lock(mutex);
+
+    auto known_thread = std::find(threads.begin(), threads.end(), thread);
+    if (known_thread == threads.end())
+    {
+        known_thread = threads.insert(threads.end(), thread);
+    }
+    events.push_back(Event{
+        name, category,
+        std::chrono::duration<double, std::micro>(now - start_time).count(),
+        static_cast<unsigned int>(known_thread - threads.begin())
+    });
+}
+
+std::size_t Tracer::size() const
+{
+    const std::lock_guard<std::mutex> lock(mutex);
+    return events.size();
+}
+void Tracer::clear()
+{
+    const std::lock_guard<std::mutex> lock(mutex);
+    events.clear();
+}
+
+void Tracer::write(std::ostream& stream) const
+{
+    const std::lock_guard<std::mutex> lock(mutex);
+
+    // Timestamps are written in fixed notation, and the stream's own
+    // formatting is restored afterwards.
+    const std::ios_base::fmtflags flags     = stream.flags();
+    const std::streamsize         precision = stream.precision();
+    stream << std::fixed << std::setprecision(3);
+
+    stream << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+    for (std::size_t k = 0; k < events.size(); ++k)
+    {
+        const Event& event = events[k];
+
+        stream << (k == 0 ? "\n" : ",\n") << '{';
+        if (event.name != nullptr)
+        {
+            // Names and categories are literals chosen by the caller, so
+            // they are not escaped.
+            stream << "\"name\":\"" << event.name     << "\","
+                   << "\"cat\":\""  << event.category << "\","
+                   << "\"ph\":\"B\",";
+        }
+        else { stream << "\"ph\":\"E\","; }
+
+        stream << "\"ts\":" << event.timestamp
+               << ",\"pid\":1,\"tid\":" << event.thread << '}';
+    }
+    stream << "\n]}\n";
+
+    stream.flags(flags);
+    stream.precision(precision);
+}
+bool Tracer::write(const char* const path) const
+{
+    std::ofstream file(path);
+    if (!file) { return false; }
+
+    write(file);
+    return static_cast<bool>(file);
+}
@@ -0,0 +1,71 @@
+#include <vector>
+
+#include <catch.hpp>
+
+#include <hungarian_algorithm.h>
+
+#include "random_instance.h"
+
+
+using rharel::hungarian_algorithm::Problem;
+using rharel::hungarian_algorithm::SolveStatus;
+
+
+/// Generates the random instance the tests below solve.
+RandomInstance anytime_instance(const unsigned int n)
+{
+    return RandomInstance(n, /* seed: */ n + 7, /* greatest cost: */ 999);
+}
+
+TEST_CASE("Bounds the optimal cost at every step")
+{
+    const unsigned int n = 30;
+    RandomInstance instance = anytime_instance(n);
+
+    std::vector<unsigned int> assignment(n);
+    Problem(n, instance.copy()).solve(assignment.data());
+    const unsigned long long optimum = instance.total_cost(assignment);
+
+    Problem problem(n, instance.copy());
+    unsigned long long previous_lower_bound = 0;
+    do
+    {
+        REQUIRE(problem.lower_bound() >= previous_lower_bound);
+        REQUIRE(problem.lower_bound() <= optimum);
+        REQUIRE(problem.upper_bound() >= optimum);
+        previous_lower_bound = problem.lower_bound();
+    }
+    while (!problem.step());
+
+    REQUIRE(problem.lower_bound() == optimum);
+    REQUIRE(problem.upper_bound() == optimum);
+}
+TEST_CASE("Stops within the relative gap tolerance")
+{
+    const unsigned int n = 60;
+    RandomInstance instance = anytime_instance(n);
+
+    for (const double tolerance : { 0.0, 0.001, 0.05, 0.5 })
+    {
+        std::vector<unsigned int> assignment(n);
+
+        Problem problem(n, instance.copy());
+        const SolveStatus status = problem.solve(assignment.data(), tolerance);
+
+        std::vector<bool> is_assigned(n, false);
+        for (const unsigned int j : assignment)
+        {
+            REQUIRE(j < n);
+            REQUIRE(!is_assigned[j]);
+            is_assigned[j] = true;
+        }
+        const unsigned long long cost = instance.total_cost(assignment);
+        REQUIRE(cost >= problem.lower_bound());
+        REQUIRE(cost - problem.lower_bound() <= tolerance * cost);
+        if (status == SolveStatus::Optimal) 
+        { 
+            REQUIRE(cost == problem.lower_bound()); 
+        }
+        else { REQUIRE(status == SolveStatus::WithinTolerance); }
+    }
+}
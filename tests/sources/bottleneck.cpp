@@ -0,0 +1,80 @@
+#include <algorithm>
+#include <vector>
+
+#include <catch.hpp>
+
+#include <bottleneck.h>
+
+#include "random_instance.h"
+
+
+using rharel::hungarian_algorithm::solve_for_bottleneck_assignment;
+
+
+/// Requires that an assignment is a permutation with the specified maximum
+/// cost.
+void require_bottleneck(const std::vector<unsigned int>& C,
+                        const unsigned int               n,
+                        const std::vector<unsigned int>& solution,
+                        const unsigned int               bottleneck)
+{
+    std::vector<bool> is_taken(n, false);
+    unsigned int maximum_cost = 0;
+    for (unsigned int i = 0; i < n; ++i)
+    {
+        REQUIRE(solution[i] < n);
+        REQUIRE_FALSE(is_taken[solution[i]]);
+        is_taken[solution[i]] = true;
+        maximum_cost = std::max(maximum_cost, C[i * n + solution[i]]);
+    }
+    REQUIRE(maximum_cost == bottleneck);
+}
+
+TEST_CASE("Solves bottleneck assignments")
+{
+    for (unsigned int n = 1; n <= 7; ++n)
+    {
+        for (unsigned int seed = 0; seed < 20; ++seed)
+        {
+            RandomInstance instance(n, /* seed: */ 20 * n + seed,
+                                    /* greatest cost: */ 
+                                    seed % 2 == 0 ? 9 : 999);
+            const std::vector<unsigned int>& C = instance.C;
+
+            std::vector<unsigned int> solution(n);
+            const unsigned int bottleneck = solve_for_bottleneck_assignment(
+                n, instance.copy(), solution.data()
+            );
+            const auto least_bottleneck = ranked_costs_by_enumeration(
+                n,
+                [&C, n](const std::vector<unsigned int>& assignment)
+                {
+                    unsigned int greatest_cost = 0;
+                    for (unsigned int i = 0; i < n; ++i)
+                    {
+                        greatest_cost = std::max(greatest_cost, 
+                                                 C[i * n + assignment[i]]);
+                    }
+                    return static_cast<unsigned long long>(greatest_cost);
+                }
+            ).front();
+            REQUIRE(bottleneck == least_bottleneck);
+            require_bottleneck(C, n, solution, bottleneck);
+        }
+    }
+}
+TEST_CASE("Solves bottleneck assignments from a cost function")
+{
+    // The anti-diagonal is the only assignment avoiding the large costs.
+    const unsigned int n = 200;
+    const auto cost = [](const unsigned int i, const unsigned int j)
+    {
+        return i + j == n - 1 ? i : 1000 + i * j;
+    };
+    std::vector<unsigned int> solution(n);
+    const unsigned int bottleneck = solve_for_bottleneck_assignment(
+        n, cost, solution.data()
+    );
+    REQUIRE(bottleneck == n - 1);
+    for (unsigned int i = 0; i < n; ++i) { REQUIRE(solution[i] == n - 1 - i); }
+}
@@ -0,0 +1,139 @@
+#include <utility>
+#include <vector>
+
+#include <catch.hpp>
+
+#include <hungarian_algorithm.h>
+
+#include "random_instance.h"
+
+
+using rharel::hungarian_algorithm::find_partial_assignment;
+using rharel::hungarian_algorithm::solve_for_minimum_cost_assignment;
+using rharel::hungarian_algorithm::solve_for_minimum_cost_assignment_lazily;
+using rharel::hungarian_algorithm::verify;
+
+
+/// Generates the random instance the tests below certify.
+RandomInstance certified_instance(const unsigned int n)
+{
+    return RandomInstance(n, /* seed: */ 3 * n + 1, /* greatest cost: */ 999);
+}
+
+/// Requires that a certified optimal assignment passes verification, and 
+/// that tampering with it or its certificate is detected.
+void require_certificate_holds(const RandomInstance& instance,
+                               std::vector<unsigned int> assignment,
+                               std::vector<long long>    u,
+                               std::vector<long long>    v)
+{
+    const unsigned int n = instance.n;
+    const unsigned int* const* const C = instance.C_row_pointers.data();
+
+    REQUIRE(verify(n, C, assignment.data(), u.data(), v.data()));
+
+    unsigned long long dual_objective = 0;
+    for (unsigned int k = 0; k < n; ++k) { dual_objective += u[k] + v[k]; }
+    REQUIRE(instance.total_cost(assignment) == dual_objective);
+
+    // A worse assignment violates complementary slackness.
+    std::vector<unsigned int> swapped = assignment;
+    std::swap(swapped[0], swapped[1]);
+    if (instance.total_cost(swapped) != instance.total_cost(assignment))
+    {
+        REQUIRE(!verify(n, C, swapped.data(), u.data(), v.data()));
+    }
+    // Raising a potential violates dual feasibility.
+    u[0] += 1;
+    REQUIRE(!verify(n, C, assignment.data(), u.data(), v.data()));
+    u[0] -= 1;
+    // Not a permutation.
+    assignment[1] = assignment[0];
+    REQUIRE(!verify(n, C, assignment.data(), u.data(), v.data()));
+}
+
+TEST_CASE("Certifies the Munkres solution")
+{
+    const unsigned int n = 40;
+    RandomInstance instance = certified_instance(n);
+
+    std::vector<unsigned int> assignment(n);
+    std::vector<long long>    u(n), v(n);
+    const unsigned long long total_cost = solve_for_minimum_cost_assignment(
+        n, instance.copy(), assignment.data(), u.data(), v.data()
+    );
+    REQUIRE(total_cost == instance.total_cost(assignment));
+    require_certificate_holds(instance, assignment, u, v);
+}
+TEST_CASE("Certifies the augmenting path solution")
+{
+    const unsigned int n = 40;
+    const RandomInstance instance = certified_instance(n);
+    const unsigned int* const costs = instance.C.data();
+
+    std::vector<unsigned int> assignment(n);
+    std::vector<long long>    u(n), v(n);
+    solve_for_minimum_cost_assignment_lazily(
+        n,
+        [costs, n](const unsigned int i, const unsigned int j)
+        {
+            return costs[i * n + j];
+        },
+        /* cached_row_count: */ 0, assignment.data(), u.data(), v.data()
+    );
+    require_certificate_holds(instance, assignment, u, v);
+}
+TEST_CASE("Certifies trivial problems")
+{
+    unsigned int  cost  = 7;
+    unsigned int* row   = &cost;
+    unsigned int  assignment;
+    long long     u, v;
+    REQUIRE(solve_for_minimum_cost_assignment(1, &row, &assignment, &u, &v) 
+            == 7);
+    REQUIRE(verify(1, &row, &assignment, &u, &v));
+
+    solve_for_minimum_cost_assignment_lazily(
+        1, [](unsigned int, unsigned int) { return 7u; },
+        /* cached_row_count: */ 0, &assignment, &u, &v
+    );
+    REQUIRE(verify(1, &row, &assignment, &u, &v));
+}
+TEST_CASE("Finds a partial assignment with feasible potentials")
+{
+    const unsigned int n = 40;
+    const RandomInstance instance = certified_instance(n);
+    const unsigned int* const costs = instance.C.data();
+
+    std::vector<unsigned int> assignment(n);
+    std::vector<long long>    u(n), v(n);
+    const unsigned int assigned_count = find_partial_assignment(
+        n,
+        [costs, n](const unsigned int i, const unsigned int j)
+        {
+            return costs[i * n + j];
+        },
+        assignment.data(), u.data(), v.data()
+    );
+    REQUIRE(assigned_count > 0);
+
+    std::vector<bool> is_assigned_column(n, false);
+    unsigned int      row_count = 0;
+    for (unsigned int i = 0; i < n; ++i)
+    {
+        for (unsigned int j = 0; j < n; ++j)
+        {
+            const long long reduced_cost = 
+                static_cast<long long>(costs[i * n + j]) - u[i] - v[j];
+            REQUIRE(reduced_cost >= 0);
+            if (assignment[i] == j) { REQUIRE(reduced_cost == 0); }
+        }
+        if (assignment[i] == n) { continue; }
+
+        REQUIRE(assignment[i] < n);
+        REQUIRE(!is_assigned_column[assignment[i]]);
+        is_assigned_column[assignment[i]] = true;
+        ++ row_count;
+    }
+    REQUIRE(row_count == assigned_count);
+}
@@ -0,0 +1,289 @@
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <random>
+#include <vector>
+
+#include <catch.hpp>
+
+#include <cost_matrix_file.h>
+#include <hungarian_algorithm.h>
+
+
+using rharel::hungarian_algorithm::CostEncoding;
+using rharel::hungarian_algorithm::CostMatrixReader;
+using rharel::hungarian_algorithm::CostMatrixStreamReader;
+using rharel::hungarian_algorithm::CostMatrixView;
+using rharel::hungarian_algorithm::CostMatrixWriter;
+using rharel::hungarian_algorithm::MappedCostMatrix;
+using rharel::hungarian_algorithm::solve_for_minimum_cost_assignment;
+using rharel::hungarian_algorithm::write_cost_matrix_file;
+
+
+/// The path of the file tests write to.
+const char* const cost_matrix_file_path = "test_cost_matrix.bin";
+
+/// Writes a random nxn matrix with the specified encoding, maps it back, and
+/// requires that it reads the same and solves to the same minimum cost.
+void test_mapped(const unsigned int n, const CostEncoding encoding)
+{
+    const unsigned int maximum_cost = 
+        encoding == CostEncoding::UInt8  ? 255   :
+        encoding == CostEncoding::UInt16 ? 65535 : 1000000;
+    std::mt19937 random(n);
+    std::uniform_int_distribution<unsigned int> random_cost(0, maximum_cost);
+
+    std::vector<std::vector<unsigned int>> C(n, std::vector<unsigned int>(n));
+    std::vector<unsigned int*>             C_row_pointers(n);
+    for (unsigned int i = 0; i < n; ++i)
+    {
+        for (auto& cost : C[i]) { cost = random_cost(random); }
+        C_row_pointers[i] = C[i].data();
+    }
+    REQUIRE(write_cost_matrix_file(cost_matrix_file_path, n, 
+                                   C_row_pointers.data(), encoding));
+    {
+        MappedCostMatrix mapped;
+        REQUIRE(mapped.open(cost_matrix_file_path));
+        REQUIRE(mapped.size()     == n);
+        REQUIRE(mapped.encoding() == encoding);
+        for (unsigned int i = 0; i < n; ++i)
+        {
+            for (unsigned int j = 0; j < n; ++j) 
+            { 
+                REQUIRE(mapped(i, j) == C[i][j]); 
+            }
+        }
+        std::vector<unsigned int> mapped_solution(n);
+        solve_for_minimum_cost_assignment(mapped, mapped_solution.data());
+
+        const std::vector<std::vector<unsigned int>> original = C;
+        std::vector<unsigned int> solution(n);
+        solve_for_minimum_cost_assignment(n, C_row_pointers.data(), 
+                                          solution.data());
+
+        unsigned long long mapped_cost = 0, cost = 0;
+        for (unsigned int i = 0; i < n; ++i)
+        {
+            mapped_cost += original[i][mapped_solution[i]];
+            cost        += original[i][solution[i]];
+        }
+        REQUIRE(mapped_cost == cost);
+    }
+    std::remove(cost_matrix_file_path);
+}
+TEST_CASE("Maps cost matrix file [n = 30, 8-bit]")  
+{ 
+    test_mapped(30, CostEncoding::UInt8);  
+}
+TEST_CASE("Maps cost matrix file [n = 30, 16-bit]") 
+{ 
+    test_mapped(30, CostEncoding::UInt16); 
+}
+TEST_CASE("Maps cost matrix file [n = 70, 32-bit]") 
+{ 
+    test_mapped(70, CostEncoding::UInt32); 
+}
+TEST_CASE("Rejects costs that do not fit the encoding")
+{
+    std::vector<unsigned int> row = { 0, 256 };
+    std::vector<unsigned int> other_row = { 1, 2 };
+    const unsigned int* const C[] = { row.data(), other_row.data() };
+
+    REQUIRE_FALSE(write_cost_matrix_file(cost_matrix_file_path, 2, C, 
+                                         CostEncoding::UInt8));
+    std::remove(cost_matrix_file_path);
+}
+TEST_CASE("Rejects files without a valid header")
+{
+    {
+        std::ofstream file(cost_matrix_file_path, std::ios::binary);
+        file << "NOTACOSTMATRIX";
+    }
+    MappedCostMatrix mapped;
+    REQUIRE_FALSE(mapped.open(cost_matrix_file_path));
+    REQUIRE_FALSE(mapped.is_open());
+    std::remove(cost_matrix_file_path);
+}
+
+/// Writes a batch of random matrices of various sizes with the specified 
+/// encoding, and requires that both readers read them back unchanged.
+void test_round_trip(const CostEncoding encoding)
+{
+    const unsigned int sizes[] = { 0, 1, 7, 33, 64 };
+
+    std::mt19937 random(static_cast<unsigned int>(encoding));
+    std::uniform_int_distribution<unsigned int> random_cost(0, 255);
+
+    std::vector<std::vector<std::vector<unsigned int>>> batch;
+    std::ostringstream output(std::ios::binary);
+    CostMatrixWriter   writer(output);
+    for (const unsigned int n : sizes)
+    {
+        std::vector<std::vector<unsigned int>> C(
+            n, std::vector<unsigned int>(n)
+        );
+        std::vector<const unsigned int*> C_row_pointers(n);
+        for (unsigned int i = 0; i < n; ++i)
+        {
+            for (auto& cost : C[i]) { cost = random_cost(random); }
+            C_row_pointers[i] = C[i].data();
+        }
+        REQUIRE(writer.write(n, C_row_pointers.data(), encoding));
+        batch.push_back(C);
+    }
+    const std::string bytes = output.str();
+
+    CostMatrixReader reader(
+        reinterpret_cast<const unsigned char*>(bytes.data()), bytes.size()
+    );
+    std::istringstream     input(bytes, std::ios::binary);
+    CostMatrixStreamReader stream_reader(input);
+    for (const auto& C : batch)
+    {
+        const unsigned int n = static_cast<unsigned int>(C.size());
+
+        CostMatrixView view, stream_view;
+        REQUIRE(reader.next(view));
+        REQUIRE(stream_reader.next(stream_view));
+        REQUIRE(view.size()        == n);
+        REQUIRE(stream_view.size() == n);
+        for (unsigned int i = 0; i < n; ++i)
+        {
+            for (unsigned int j = 0; j < n; ++j)
+            {
+                REQUIRE(view(i, j)        == C[i][j]);
+                REQUIRE(stream_view(i, j) == C[i][j]);
+            }
+        }
+        if (encoding == CostEncoding::UInt32 && n > 0)
+        {
+            // Fixed-width records are not copied.
+            REQUIRE(view.payload() >= 
+                    reinterpret_cast<const unsigned char*>(bytes.data()));
+            REQUIRE(view.payload() < 
+                    reinterpret_cast<const unsigned char*>(bytes.data()) + 
+                    bytes.size());
+        }
+    }
+    CostMatrixView view;
+    REQUIRE_FALSE(reader.next(view));
+    REQUIRE_FALSE(reader.failed());
+    REQUIRE_FALSE(stream_reader.next(view));
+    REQUIRE_FALSE(stream_reader.failed());
+}
+TEST_CASE("Round-trips cost matrix batch [8-bit]")  
+{ 
+    test_round_trip(CostEncoding::UInt8);  
+}
+TEST_CASE("Round-trips cost matrix batch [32-bit]") 
+{ 
+    test_round_trip(CostEncoding::UInt32); 
+}
+TEST_CASE("Round-trips cost matrix batch [varint]") 
+{ 
+    test_round_trip(CostEncoding::Varint); 
+}
+TEST_CASE("Round-trips cost matrix batch [delta varint]") 
+{ 
+    test_round_trip(CostEncoding::DeltaVarint); 
+}
+TEST_CASE("Rejects truncated cost matrix records")
+{
+    std::vector<unsigned int> row = { 1000, 3 }, other_row = { 7, 0 };
+    const unsigned int* const C[] = { row.data(), other_row.data() };
+
+    std::ostringstream output(std::ios::binary);
+    REQUIRE(CostMatrixWriter(output).write(2, C, CostEncoding::Varint));
+    const std::string bytes = output.str().substr(0, 66);
+
+    CostMatrixReader reader(
+        reinterpret_cast<const unsigned char*>(bytes.data()), bytes.size()
+    );
+    CostMatrixView view;
+    REQUIRE_FALSE(reader.next(view));
+    REQUIRE(reader.failed());
+}
+TEST_CASE("Rejects delta varint records leaving the range of costs")
+{
+    std::vector<unsigned int> row = { 1, 2 }, other_row = { 3, 4 };
+    const unsigned int* const C[] = { row.data(), other_row.data() };
+
+    std::ostringstream output(std::ios::binary);
+    REQUIRE(CostMatrixWriter(output).write(2, C, CostEncoding::DeltaVarint));
+    const std::string header = output.str().substr(0, 64);
+
+    // Returns true iff both readers accept the record, with the delta of
+    // its first row replaced by the specified zigzag encoding.
+    const auto is_accepted = [&header](const std::uint64_t zigzag)
+    {
+        std::string payload = "\x01";
+        std::uint64_t value = zigzag;
+        for (; value >= 0x80; value >>= 7)
+        {
+            payload += static_cast<char>((value & 0x7F) | 0x80);
+        }
+        payload += static_cast<char>(value);
+        payload += "\x03\x02";
+
+        std::string bytes = header;
+        for (unsigned int k = 0; k < 8; ++k)
+        {
+            bytes[24 + k] = 
+                static_cast<char>((payload.size() >> (8 * k)) & 0xFF);
+        }
+        bytes += payload;
+        bytes.resize(64 + 64, '\0');
+
+        CostMatrixReader reader(
+            reinterpret_cast<const unsigned char*>(bytes.data()), 
+            bytes.size()
+        );
+        std::istringstream     input(bytes, std::ios::binary);
+        CostMatrixStreamReader stream_reader(input);
+        CostMatrixView view, stream_view;
+        const bool is_read        = reader.next(view),
+                   is_stream_read = stream_reader.next(stream_view);
+        REQUIRE(is_read == is_stream_read);
+        REQUIRE(reader.failed()        == !is_read);
+        REQUIRE(stream_reader.failed() == !is_stream_read);
+
+        return is_read;
+    };
+    REQUIRE(is_accepted(2));  // +1.
+    // 2^63 - 1 would overflow a signed sum, -2^63 takes the cost below 
+    // zero, and 2^32 - 1 takes it above the greatest cost.
+    REQUIRE_FALSE(is_accepted(UINT64_MAX - 1));
+    REQUIRE_FALSE(is_accepted(UINT64_MAX));
+    REQUIRE_FALSE(is_accepted(2 * static_cast<std::uint64_t>(UINT32_MAX)));
+}
+TEST_CASE("Rejects streamed records claiming more than they hold")
+{
+    std::vector<unsigned int> row = { 1, 2 }, other_row = { 3, 4 };
+    const unsigned int* const C[] = { row.data(), other_row.data() };
+
+    std::ostringstream output(std::ios::binary);
+    REQUIRE(CostMatrixWriter(output).write(2, C, CostEncoding::UInt32));
+    std::string bytes = output.str();
+
+    // Claims n = 65536, whose 32-bit costs would take 16 GiB.
+    const unsigned int n = 65536;
+    const unsigned long long payload_size = 4ull * n * n;
+    for (unsigned int k = 0; k < 4; ++k)
+    {
+        bytes[16 + k] = static_cast<char>((n >> (8 * k)) & 0xFF);
+        bytes[20 + k] = static_cast<char>((n >> (8 * k)) & 0xFF);
+    }
+    for (unsigned int k = 0; k < 8; ++k)
+    {
+        bytes[24 + k] = static_cast<char>((payload_size >> (8 * k)) & 0xFF);
+    }
+
+    std::istringstream     input(bytes, std::ios::binary);
+    CostMatrixStreamReader reader(input);
+    CostMatrixView view;
+    REQUIRE_FALSE(reader.next(view));
+    REQUIRE(reader.failed());
+}
@@ -0,0 +1,209 @@
+#include <algorithm>
+#include <numeric>
+#include <random>
+#include <vector>
+
+#include <catch.hpp>
+
+#include <decomposition.h>
+#include <hungarian_algorithm.h>
+#include <submatrix_view.h>
+
+
+using rharel::hungarian_algorithm::SubmatrixView;
+using rharel::hungarian_algorithm::assign_forced_pairs;
+using rharel::hungarian_algorithm::forbidden_cost;
+using rharel::hungarian_algorithm::
+      solve_for_minimum_cost_assignment_by_components;
+using rharel::hungarian_algorithm::solve_for_minimum_cost_assignment;
+
+
+/// Generates an nxn matrix of blocks of the specified sizes along the
+/// diagonal, with rows and columns shuffled. Pairs outside blocks are
+/// forbidden, as are some pairs within them. If a cross pair probability is
+/// specified, rows of each block may also take columns of the blocks before
+/// it at low cost, though no assignment includes such pairs.
+std::vector<unsigned int> generate_block_instance(
+    const std::vector<unsigned int>& block_sizes,
+    const unsigned int               seed,
+    const double                     cross_pair_probability = 0)
+{
+    const unsigned int n = std::accumulate(block_sizes.begin(),
+                                           block_sizes.end(), 0u);
+    std::mt19937 random(seed);
+    std::uniform_int_distribution<unsigned int> random_cost(0, 99);
+    std::bernoulli_distribution is_forbidden(0.2);
+    std::bernoulli_distribution is_cross_pair(cross_pair_probability);
+
+    std::vector<unsigned int> row_order(n), column_order(n);
+    std::iota(row_order.begin(),    row_order.end(),    0);
+    std::iota(column_order.begin(), column_order.end(), 0);
+    std::shuffle(row_order.begin(),    row_order.end(),    random);
+    std::shuffle(column_order.begin(), column_order.end(), random);
+
+    std::vector<unsigned int> C(n * n, forbidden_cost);
+    unsigned int offset = 0;
+    for (const unsigned int size : block_sizes)
+    {
+        for (unsigned int a = offset; a < offset + size; ++a)
+        {
+            for (unsigned int b = offset; b < offset + size; ++b)
+            {
+                // Keeps the block's diagonal, so it has an assignment.
+                if (a != b && is_forbidden(random)) { continue; }
+                C[row_order[a] * n + column_order[b]] = random_cost(random);
+            }
+            for (unsigned int b = 0; b < offset; ++b)
+            {
+                if (!is_cross_pair(random)) { continue; }
+                C[row_order[a] * n + column_order[b]] = 0;
+            }
+        }
+        offset += size;
+    }
+    return C;
+}
+/// Solves an instance by components, and requires the same cost as a
+/// monolithic solve that penalizes forbidden pairs.
+void test_components(const std::vector<unsigned int>& block_sizes,
+                     const unsigned int               seed,
+                     const unsigned int               thread_count,
+                     const double                     cross_probability = 0)
+{
+    std::vector<unsigned int> C = generate_block_instance(
+        block_sizes, seed, cross_probability
+    );
+    const unsigned int n = std::accumulate(block_sizes.begin(),
+                                           block_sizes.end(), 0u);
+
+    std::vector<unsigned int*> C_rows(n);
+    for (unsigned int i = 0; i < n; ++i) { C_rows[i] = &C[i * n]; }
+
+    std::vector<unsigned int> solution(n);
+    REQUIRE(solve_for_minimum_cost_assignment_by_components(
+        n, C_rows.data(), solution.data(), thread_count
+    ));
+
+    // The Munkres procedure modifies its cost matrix, so solves a copy.
+    std::vector<unsigned int> penalized = C;
+    for (auto& cost : penalized)
+    {
+        if (cost == forbidden_cost) { cost = 1000000; }
+    }
+    std::vector<unsigned int*> penalized_rows(n);
+    for (unsigned int i = 0; i < n; ++i)
+    {
+        penalized_rows[i] = &penalized[i * n];
+    }
+    std::vector<unsigned int> expected_solution(n);
+    const std::vector<unsigned int> penalized_costs = penalized;
+    solve_for_minimum_cost_assignment(n, penalized_rows.data(),
+                                      expected_solution.data());
+
+    std::vector<bool> is_taken(n, false);
+    unsigned long long cost = 0, expected_cost = 0;
+    for (unsigned int i = 0; i < n; ++i)
+    {
+        REQUIRE(solution[i] < n);
+        REQUIRE_FALSE(is_taken[solution[i]]);
+        is_taken[solution[i]] = true;
+        REQUIRE(C[i * n + solution[i]] != forbidden_cost);
+
+        cost          += C[i * n + solution[i]];
+        expected_cost += penalized_costs[i * n + expected_solution[i]];
+    }
+    REQUIRE(cost == expected_cost);
+}
+
+TEST_CASE("Solves by components")
+{
+    for (unsigned int seed = 0; seed < 10; ++seed)
+    {
+        test_components({ 1, 5, 12, 3, 30, 7 }, seed, /* thread count: */ 1);
+        test_components({ 1, 5, 12, 3, 30, 7 }, seed, /* thread count: */ 4);
+    }
+    test_components({ 40 }, 0, /* thread count: */ 4);
+    test_components({}, 0, /* thread count: */ 1);
+}
+TEST_CASE("Eliminates pairs in no assignment")
+{
+    // Every row may take columns of earlier blocks at no cost, so the
+    // allowed pairs connect all blocks, yet each block takes its own
+    // columns.
+    for (unsigned int seed = 0; seed < 10; ++seed)
+    {
+        test_components({ 1, 5, 12, 3, 30, 7 }, seed, /* thread count: */ 1,
+                        /* cross pair probability: */ 0.3);
+        test_components({ 1, 5, 12, 3, 30, 7 }, seed, /* thread count: */ 4,
+                        /* cross pair probability: */ 0.3);
+    }
+}
+TEST_CASE("Reports components without assignments")
+{
+    const unsigned int f = forbidden_cost;
+    // Rows 0 and 1 may only take column 0.
+    std::vector<unsigned int> C = {
+        1, f, f,
+        2, f, f,
+        f, 3, 4,
+    };
+    std::vector<unsigned int*> C_rows = { &C[0], &C[3], &C[6] };
+    std::vector<unsigned int> solution(3);
+    REQUIRE_FALSE(solve_for_minimum_cost_assignment_by_components(
+        3, C_rows.data(), solution.data()
+    ));
+
+    // Square component without an assignment avoiding forbidden pairs.
+    C = {
+        1, 2, f,
+        f, f, 3,
+        f, f, 4,
+    };
+    REQUIRE_FALSE(solve_for_minimum_cost_assignment_by_components(
+        3, C_rows.data(), solution.data()
+    ));
+}
+TEST_CASE("Assigns forced pairs")
+{
+    const unsigned int f = forbidden_cost;
+    // Row 0 forces column 2, which leaves row 1 only column 0, and column 1
+    // only row 2. Rows 3 and 4 remain free to choose.
+    std::vector<unsigned int> C = {
+        f, f, 5, f, f,
+        1, f, 9, f, f,
+        7, 2, 3, f, f,
+        f, 6, f, 4, 8,
+        f, f, f, 1, 2,
+    };
+    std::vector<unsigned int*> C_rows(5);
+    for (unsigned int i = 0; i < 5; ++i) { C_rows[i] = &C[i * 5]; }
+
+    std::vector<unsigned int> solution(5);
+    REQUIRE(solve_for_minimum_cost_assignment_by_components(
+        5, C_rows.data(), solution.data()
+    ));
+    REQUIRE(solution == std::vector<unsigned int>({ 2, 0, 1, 3, 4 }));
+
+    // The presolve alone assigns the forced pairs, leaves the other rows
+    // untouched, and selects the rest for any solver.
+    std::vector<unsigned int> forced(5, 5);
+    std::vector<unsigned int> rows, columns;
+    REQUIRE(assign_forced_pairs(5, C_rows.data(), forced.data(),
+                                rows, columns));
+    REQUIRE(forced  == std::vector<unsigned int>({ 2, 0, 1, 5, 5 }));
+    REQUIRE(rows    == std::vector<unsigned int>({ 3, 4 }));
+    REQUIRE(columns == std::vector<unsigned int>({ 3, 4 }));
+
+    const SubmatrixView residual(C_rows.data(), 2, rows.data(),
+                                 columns.data());
+    REQUIRE(solve_for_minimum_cost_assignment(residual, forced.data()) == 6);
+    REQUIRE(forced == solution);
+
+    // Forcing column 2 leaves row 1 with no pairs.
+    C[1 * 5 + 0] = f;
+    REQUIRE_FALSE(assign_forced_pairs(5, C_rows.data(), forced.data(),
+                                      rows, columns));
+    REQUIRE_FALSE(solve_for_minimum_cost_assignment_by_components(
+        5, C_rows.data(), solution.data()
+    ));
+}
@@ -0,0 +1,60 @@
+#include <random>
+#include <vector>
+
+#include <catch.hpp>
+
+#include <hungarian_algorithm.h>
+#include <inner_product_costs.h>
+
+
+using rharel::hungarian_algorithm::InnerProductCost;
+using rharel::hungarian_algorithm::solve_for_minimum_cost_assignment;
+using rharel::hungarian_algorithm::solve_for_maximum_inner_product_assignment;
+
+
+/// Solves a random nxn inner product problem implicitly and through a 
+/// materialized cost matrix, and requires the same total cost from both.
+void test_inner_product(const unsigned int n, const unsigned int d)
+{
+    std::mt19937 random(n + d);
+    std::normal_distribution<float> random_coordinate;
+
+    std::vector<float> A(n * d), B(n * d);
+    for (float& x : A) { x = random_coordinate(random); }
+    for (float& x : B) { x = random_coordinate(random); }
+
+    const float scale = 1000.0f;
+    const InnerProductCost cost(n, d, A.data(), B.data(), scale);
+
+    std::vector<unsigned int> implicit_solution(n);
+    solve_for_maximum_inner_product_assignment(n, d, A.data(), B.data(), 
+                                               scale, 
+                                               implicit_solution.data());
+    std::vector<unsigned int> dense_solution(n);
+    solve_for_minimum_cost_assignment(n, cost, dense_solution.data());
+
+    unsigned long long implicit_cost = 0, dense_cost = 0;
+    std::vector<bool> is_assigned_task(n, false);
+    for (unsigned int i = 0; i < n; ++i)
+    {
+        REQUIRE(implicit_solution[i] < n);
+        REQUIRE_FALSE(is_assigned_task[implicit_solution[i]]);
+        is_assigned_task[implicit_solution[i]] = true;
+
+        implicit_cost += cost(i, implicit_solution[i]);
+        dense_cost    += cost(i, dense_solution[i]);
+    }
+    REQUIRE(implicit_cost == dense_cost);
+}
+TEST_CASE("Solves inner product assignment [n =  1, d = 4]")  
+{ 
+    test_inner_product(1, 4); 
+}
+TEST_CASE("Solves inner product assignment [n = 40, d = 8]")  
+{ 
+    test_inner_product(40, 8); 
+}
+TEST_CASE("Solves inner product assignment [n = 60, d = 32]") 
+{ 
+    test_inner_product(60, 32); 
+}
@@ -0,0 +1,96 @@
+#include <algorithm>
+#include <set>
+#include <vector>
+
+#include <catch.hpp>
+
+#include <k_best.h>
+
+#include "random_instance.h"
+
+
+using rharel::hungarian_algorithm::solve_for_k_best_assignments;
+
+
+/// Ranks the k best assignments of a random nxn matrix and compares them to
+/// those found by enumeration.
+void test_k_best(const unsigned int n,
+                 const unsigned int k,
+                 const unsigned int maximum_cost,
+                 const unsigned int seed,
+                 const unsigned int thread_count = 1)
+{
+    const RandomInstance instance(n, seed, maximum_cost);
+
+    std::vector<unsigned int>       solutions(k * n);
+    std::vector<unsigned int*>      solution_rows(k);
+    std::vector<unsigned long long> costs(k);
+    for (unsigned int s = 0; s < k; ++s) 
+    { 
+        solution_rows[s] = &solutions[s * n]; 
+    }
+
+    const unsigned int found_count = solve_for_k_best_assignments(
+        n, instance.C_row_pointers.data(), k, solution_rows.data(), 
+        costs.data(), thread_count
+    );
+
+    const auto expected_costs = ranked_costs_by_enumeration(
+        n, 
+        [&instance](const std::vector<unsigned int>& assignment)
+        {
+            return instance.total_cost(assignment);
+        }
+    );
+    REQUIRE(found_count == std::min<std::size_t>(k, expected_costs.size()));
+
+    std::set<std::vector<unsigned int>> distinct;
+    for (unsigned int s = 0; s < found_count; ++s)
+    {
+        const std::vector<unsigned int> solution(solution_rows[s],
+                                                 solution_rows[s] + n);
+        std::vector<bool> is_taken(n, false);
+        for (unsigned int i = 0; i < n; ++i)
+        {
+            REQUIRE(solution[i] < n);
+            REQUIRE_FALSE(is_taken[solution[i]]);
+            is_taken[solution[i]] = true;
+        }
+        const unsigned long long cost = instance.total_cost(solution);
+        REQUIRE(cost == costs[s]);
+        REQUIRE(cost == expected_costs[s]);
+        distinct.insert(solution);
+    }
+    REQUIRE(distinct.size() == found_count);
+}
+
+TEST_CASE("Ranks assignments")
+{
+    for (unsigned int seed = 0; seed < 20; ++seed)
+    {
+        test_k_best(/* n: */ 5, /* k: */ 30, /* maximum cost: */ 99, seed);
+    }
+}
+TEST_CASE("Ranks assignments with ties")
+{
+    for (unsigned int seed = 0; seed < 20; ++seed)
+    {
+        test_k_best(/* n: */ 6, /* k: */ 100, /* maximum cost: */ 3, seed);
+    }
+}
+TEST_CASE("Ranks all assignments when there are fewer than k")
+{
+    test_k_best(/* n: */ 1, /* k: */ 5, /* maximum cost: */ 9, 0);
+    test_k_best(/* n: */ 3, /* k: */ 10, /* maximum cost: */ 9, 0);
+    test_k_best(/* n: */ 4, /* k: */ 24, /* maximum cost: */ 9, 0);
+}
+TEST_CASE("Ranks assignments on multiple threads")
+{
+    for (unsigned int seed = 0; seed < 10; ++seed)
+    {
+        test_k_best(/* n: */ 6, /* k: */ 200, /* maximum cost: */ 9, seed,
+                    /* thread count: */ 4);
+    }
+    test_k_best(/* n: */ 3, /* k: */ 10, /* maximum cost: */ 9, 0,
+                /* thread count: */ 8);
+}
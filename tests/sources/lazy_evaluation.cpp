@@ -0,0 +1,82 @@
+#include <random>
+#include <vector>
+
+#include <catch.hpp>
+
+#include <hungarian_algorithm.h>
+
+
+using rharel::hungarian_algorithm::solve_for_minimum_cost_assignment;
+using rharel::hungarian_algorithm::solve_for_minimum_cost_assignment_lazily;
+
+
+/// Computes the total cost of an assignment.
+unsigned long long total_cost(
+    const std::vector<std::vector<unsigned int>>& C,
+    const std::vector<unsigned int>&              assignment)
+{
+    unsigned long long cost = 0;
+    for (unsigned int i = 0; i < assignment.size(); ++i) 
+    { 
+        cost += C[i][assignment[i]]; 
+    }
+    return cost;
+}
+/// Requires that the specified solution assigns each task exactly once.
+void require_solution_is_permutation(const std::vector<unsigned int>& solution)
+{
+    std::vector<bool> is_assigned_task(solution.size(), false);
+    for (const unsigned int j : solution)
+    {
+        REQUIRE(j < solution.size());
+        REQUIRE_FALSE(is_assigned_task[j]);
+        is_assigned_task[j] = true;
+    }
+}
+/// Solves a random nxn problem both lazily, caching the specified number of 
+/// rows, and eagerly, and requires the same minimum cost from both.
+void test(const unsigned int n, const unsigned int cached_row_count)
+{
+    std::mt19937 random(n);
+    std::uniform_int_distribution<unsigned int> random_cost(0, 100);
+
+    std::vector<std::vector<unsigned int>> C(n, std::vector<unsigned int>(n));
+    for (auto& row : C) { for (auto& cost : row) { cost = random_cost(random); } }
+
+    unsigned long long evaluation_count = 0;
+    std::vector<unsigned int> lazy_solution(n);
+    solve_for_minimum_cost_assignment_lazily(
+        /* problem_size:  */ n,
+        /* cost function: */ [&C, &evaluation_count](const unsigned int i, 
+                                                    const unsigned int j) 
+                                { 
+                                    ++ evaluation_count;
+                                    return C[i][j]; 
+                                }, 
+        /* cache size:    */ cached_row_count,
+        lazy_solution.data()
+    );
+    if (cached_row_count >= n) 
+    { 
+        REQUIRE(evaluation_count <= static_cast<unsigned long long>(n) * n); 
+    }
+
+    std::vector<unsigned int> eager_solution(n);
+    solve_for_minimum_cost_assignment(
+        /* problem_size:  */ n,
+        /* cost function: */ [&C](const unsigned int i, const unsigned int j) 
+                                { 
+                                    return C[i][j]; 
+                                }, 
+        eager_solution.data()
+    );
+    require_solution_is_permutation(lazy_solution);
+    REQUIRE(total_cost(C, lazy_solution) == total_cost(C, eager_solution));
+}
+TEST_CASE("Solves lazily [n =  1, no cache]")   { test(1,  0);  }
+TEST_CASE("Solves lazily [n =  5, no cache]")   { test(5,  0);  }
+TEST_CASE("Solves lazily [n = 30, no cache]")   { test(30, 0);  }
+TEST_CASE("Solves lazily [n = 30, 1 row]")      { test(30, 1);  }
+TEST_CASE("Solves lazily [n = 30, 4 rows]")     { test(30, 4);  }
+TEST_CASE("Solves lazily [n = 30, all rows]")   { test(30, 30); }
+TEST_CASE("Solves lazily [n = 80, 16 rows]")    { test(80, 16); }
@@ -0,0 +1,127 @@
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include <catch.hpp>
+
+#include <metric_costs.h>
+
+
+using rharel::hungarian_algorithm::Metric;
+using rharel::hungarian_algorithm::compute_metric_cost_matrix;
+using rharel::hungarian_algorithm::solve_for_minimum_metric_cost_assignment;
+
+
+/// Generates n random points in d dimensions (structure-of-arrays).
+std::vector<float> random_points(const unsigned int n, 
+                                 const unsigned int d,
+                                 std::mt19937&      random)
+{
+    std::uniform_real_distribution<float> random_coordinate(-10.0f, 10.0f);
+    std::vector<float> points(n * d);
+    for (float& x : points) { x = random_coordinate(random); }
+    return points;
+}
+/// Computes the distance between worker i and task j one pair at a time.
+double naive_distance(const Metric                metric,
+                      const unsigned int          n,
+                      const unsigned int          d,
+                      const std::vector<float>&   W,
+                      const std::vector<float>&   T,
+                      const unsigned int          i,
+                      const unsigned int          j)
+{
+    double sum = 0, W_norm = 0, T_norm = 0;
+    for (unsigned int k = 0; k < d; ++k)
+    {
+        const double w = W[k * n + i], t = T[k * n + j];
+        switch (metric)
+        {
+            case Metric::Euclidean:
+            case Metric::SquaredEuclidean: { sum += (w - t) * (w - t); break; }
+            case Metric::Manhattan:        { sum += std::fabs(w - t);   break; }
+            case Metric::Cosine:           { sum += w * t;              break; }
+        }
+        W_norm += w * w;
+        T_norm += t * t;
+    }
+    switch (metric)
+    {
+        case Metric::Euclidean: { return std::sqrt(sum); }
+        case Metric::Cosine:    { return 1 - sum / std::sqrt(W_norm * T_norm); }
+        default:                { return sum; }
+    }
+}
+/// Requires that the blocked cost matrix matches the naive one.
+void test_cost_matrix(const Metric       metric, 
+                      const unsigned int n, 
+                      const unsigned int d)
+{
+    std::mt19937 random(n * d);
+    const std::vector<float> W = random_points(n, d, random),
+                             T = random_points(n, d, random);
+
+    std::vector<std::vector<float>> C(n, std::vector<float>(n));
+    std::vector<float*>             C_row_pointers(n);
+    for (unsigned int i = 0; i < n; ++i) { C_row_pointers[i] = C[i].data(); }
+    compute_metric_cost_matrix(metric, n, d, W.data(), T.data(), 
+                               C_row_pointers.data());
+
+    for (unsigned int i = 0; i < n; ++i)
+    {
+        for (unsigned int j = 0; j < n; ++j)
+        {
+            const double expected = naive_distance(metric, n, d, W, T, i, j);
+            REQUIRE(C[i][j] == Approx(expected).epsilon(1e-3).margin(1e-3));
+        }
+    }
+}
+/// Requires that tasks placed at a permutation of the worker positions are 
+/// assigned back to their workers.
+void test_assignment(const Metric metric, const unsigned int n)
+{
+    const unsigned int d = 3;
+
+    std::mt19937 random(n);
+    const std::vector<float> W = random_points(n, d, random);
+
+    std::vector<unsigned int> permutation(n);
+    for (unsigned int i = 0; i < n; ++i) { permutation[i] = (i * 7 + 3) % n; }
+    std::vector<float> T(n * d);
+    for (unsigned int k = 0; k < d; ++k)
+    {
+        for (unsigned int i = 0; i < n; ++i) 
+        { 
+            T[k * n + permutation[i]] = W[k * n + i]; 
+        }
+    }
+    std::vector<unsigned int> solution(n);
+    solve_for_minimum_metric_cost_assignment(metric, n, d, W.data(), T.data(),
+                                             /* scale: */ 1000.0f, 
+                                             solution.data());
+    for (unsigned int i = 0; i < n; ++i) { REQUIRE(solution[i] == permutation[i]); }
+}
+TEST_CASE("Computes Euclidean costs")         
+{ 
+    test_cost_matrix(Metric::Euclidean, 300, 5); 
+}
+TEST_CASE("Computes squared Euclidean costs") 
+{ 
+    test_cost_matrix(Metric::SquaredEuclidean, 300, 5); 
+}
+TEST_CASE("Computes Manhattan costs")         
+{ 
+    test_cost_matrix(Metric::Manhattan, 300, 5); 
+}
+TEST_CASE("Computes cosine costs")            
+{ 
+    test_cost_matrix(Metric::Cosine, 300, 5); 
+}
+TEST_CASE("Solves Euclidean assignment [n = 50]") 
+{ 
+    test_assignment(Metric::Euclidean, 50); 
+}
+TEST_CASE("Solves Manhattan assignment [n = 50]") 
+{ 
+    test_assignment(Metric::Manhattan, 50); 
+}
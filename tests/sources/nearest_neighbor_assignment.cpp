@@ -0,0 +1,203 @@
+#include <random>
+#include <vector>
+
+#include <catch.hpp>
+
+#include <hungarian_algorithm.h>
+#include <nearest_neighbor_assignment.h>
+
+
+using rharel::hungarian_algorithm::CostBounds;
+using rharel::hungarian_algorithm::Metric;
+using rharel::hungarian_algorithm::compute_metric_cost_matrix;
+using rharel::hungarian_algorithm::solve_for_minimum_metric_cost_assignment;
+using rharel::hungarian_algorithm::
+      solve_for_minimum_metric_cost_assignment_sparsely;
+using rharel::hungarian_algorithm::solve_for_metric_cost_assignment_by_levels;
+using rharel::hungarian_algorithm::solve_for_minimum_cost_assignment_lazily;
+
+
+/// Generates n random points in d dimensions (structure-of-arrays), in
+/// clusters about the specified origin, so that nearest tasks are often
+/// contested.
+std::vector<float> clustered_points(const unsigned int n,
+                                    const unsigned int d,
+                                    const float        origin,
+                                    std::mt19937&      random)
+{
+    std::uniform_real_distribution<float> random_center(origin - 10.0f,
+                                                        origin + 10.0f);
+    std::normal_distribution<float>       random_offset(0.0f, 0.5f);
+    std::vector<float> centers(4 * d);
+    for (float& x : centers) { x = random_center(random); }
+
+    std::vector<float> points(n * d);
+    for (unsigned int i = 0; i < n; ++i)
+    {
+        const unsigned int c = random() % 4;
+        for (unsigned int k = 0; k < d; ++k)
+        {
+            points[k * n + i] = centers[c * d + k] + random_offset(random);
+        }
+    }
+    return points;
+}
+/// Requires that the sparse assignment is a permutation with the same total
+/// cost as the dense one.
+void test_sparse_assignment(const Metric       metric,
+                            const unsigned int n,
+                            const unsigned int d,
+                            const unsigned int candidate_count,
+                            const float        origin = 0.0f)
+{
+    std::mt19937 random(n * d + candidate_count);
+    const std::vector<float> W = clustered_points(n, d, origin, random),
+                             T = clustered_points(n, d, origin, random);
+    const float scale = 100.0f;
+
+    std::vector<std::vector<unsigned int>> C(n, std::vector<unsigned int>(n));
+    std::vector<unsigned int*>             C_row_pointers(n);
+    for (unsigned int i = 0; i < n; ++i) { C_row_pointers[i] = C[i].data(); }
+    compute_metric_cost_matrix(metric, n, d, W.data(), T.data(), scale,
+                               C_row_pointers.data());
+
+    std::vector<unsigned int> dense(n), sparse(n);
+    solve_for_minimum_metric_cost_assignment(metric, n, d, W.data(), T.data(),
+                                             scale, dense.data());
+    solve_for_minimum_metric_cost_assignment_sparsely(
+        metric, n, d, W.data(), T.data(), scale, candidate_count,
+        sparse.data()
+    );
+
+    std::vector<bool> is_assigned(n, false);
+    unsigned long long dense_cost = 0, sparse_cost = 0;
+    for (unsigned int i = 0; i < n; ++i)
+    {
+        REQUIRE(sparse[i] < n);
+        REQUIRE_FALSE(is_assigned[sparse[i]]);
+        is_assigned[sparse[i]] = true;
+
+        dense_cost  += C[i][dense[i]];
+        sparse_cost += C[i][sparse[i]];
+    }
+    REQUIRE(sparse_cost == dense_cost);
+}
+TEST_CASE("Solves sparse Euclidean assignment")
+{
+    test_sparse_assignment(Metric::Euclidean, 200, 2, /* candidates: */ 1);
+    test_sparse_assignment(Metric::Euclidean, 300, 3, /* candidates: */ 4);
+}
+TEST_CASE("Solves sparse squared Euclidean assignment")
+{
+    test_sparse_assignment(Metric::SquaredEuclidean, 300, 2, 4);
+}
+TEST_CASE("Solves sparse squared Euclidean assignment off the origin")
+{
+    // Far from the origin, costs computed from norms rather than coordinate
+    // differences would round differently from the candidates' distances.
+    test_sparse_assignment(Metric::SquaredEuclidean, 100, 2, 3, 1000.0f);
+    test_sparse_assignment(Metric::SquaredEuclidean, 200, 2, 3, 1000.0f);
+    test_sparse_assignment(Metric::SquaredEuclidean, 300, 3, 4, 1000.0f);
+}
+TEST_CASE("Solves sparse Manhattan assignment")
+{
+    test_sparse_assignment(Metric::Manhattan, 300, 4, 4);
+}
+TEST_CASE("Solves sparse cosine assignment by the full problem")
+{
+    test_sparse_assignment(Metric::Cosine, 100, 3, 4);
+}
+TEST_CASE("Solves sparse assignment with all tasks as candidates")
+{
+    test_sparse_assignment(Metric::Euclidean, 20, 2, /* candidates: */ 20);
+}
+
+/// Generates n random points in d dimensions (structure-of-arrays), uniformly
+/// in a square with a corner at the specified origin.
+std::vector<float> uniform_points(const unsigned int n,
+                                  const unsigned int d,
+                                  const float        origin,
+                                  std::mt19937&      random)
+{
+    std::uniform_real_distribution<float> random_coordinate(origin,
+                                                            origin + 10.0f);
+    std::vector<float> points(n * d);
+    for (float& x : points) { x = random_coordinate(random); }
+    return points;
+}
+/// Requires that the assignment by levels is a permutation whose cost is the
+/// upper bound returned, that the bounds are within the tolerance, and that
+/// they enclose the optimum of the full cost matrix, which is attained when
+/// there is no tolerance.
+void test_assignment_by_levels(const Metric       metric,
+                               const unsigned int n,
+                               const unsigned int d,
+                               const double       tolerance,
+                               const float        origin = 0.0f)
+{
+    std::mt19937 random(n * d);
+    const std::vector<float> W = uniform_points(n, d, origin, random),
+                             T = uniform_points(n, d, origin, random);
+    const float scale = 100.0f;
+
+    std::vector<std::vector<unsigned int>> C(n, std::vector<unsigned int>(n));
+    std::vector<unsigned int*>             C_row_pointers(n);
+    for (unsigned int i = 0; i < n; ++i) { C_row_pointers[i] = C[i].data(); }
+    compute_metric_cost_matrix(metric, n, d, W.data(), T.data(), scale,
+                               C_row_pointers.data());
+
+    std::vector<unsigned int> by_levels(n);
+    const CostBounds bounds = solve_for_metric_cost_assignment_by_levels(
+        metric, n, d, W.data(), T.data(), scale, /* candidates: */ 4,
+        tolerance, by_levels.data()
+    );
+
+    std::vector<bool> is_assigned(n, false);
+    unsigned long long cost = 0;
+    for (unsigned int i = 0; i < n; ++i)
+    {
+        REQUIRE(by_levels[i] < n);
+        REQUIRE_FALSE(is_assigned[by_levels[i]]);
+        is_assigned[by_levels[i]] = true;
+
+        cost += C[i][by_levels[i]];
+    }
+    REQUIRE(bounds.upper == cost);
+    REQUIRE(bounds.lower <= bounds.upper);
+    REQUIRE(bounds.relative_gap() <= tolerance);
+
+    std::vector<unsigned int> optimal(n);
+    solve_for_minimum_cost_assignment_lazily(
+        /* problem_size:  */ n,
+        /* cost function: */ [&C](const unsigned int i, const unsigned int j)
+                                { return C[i][j]; },
+        /* cache size:    */ n,
+        optimal.data()
+    );
+    unsigned long long optimum = 0;
+    for (unsigned int i = 0; i < n; ++i) { optimum += C[i][optimal[i]]; }
+    REQUIRE(bounds.lower <= optimum);
+    REQUIRE(optimum      <= bounds.upper);
+    if (tolerance == 0.0) { REQUIRE(bounds.upper == optimum); }
+}
+TEST_CASE("Solves assignment by levels to within the gap tolerance")
+{
+    test_assignment_by_levels(Metric::Euclidean, 2500, 2, /* gap: */ 0.01);
+    test_assignment_by_levels(Metric::Manhattan, 2500, 3, /* gap: */ 0.05);
+    test_assignment_by_levels(Metric::Euclidean, 300,  2, /* gap: */ 0.05);
+}
+TEST_CASE("Solves assignment by levels optimally with no tolerance")
+{
+    test_assignment_by_levels(Metric::Euclidean,        2500, 2, 0.0);
+    test_assignment_by_levels(Metric::SquaredEuclidean, 2049, 2, 0.0);
+    test_assignment_by_levels(Metric::Euclidean,        200,  3, 0.0);
+}
+TEST_CASE("Solves squared Euclidean assignment by levels off the origin")
+{
+    test_assignment_by_levels(Metric::SquaredEuclidean, 300, 2, 0.0, 1000.0f);
+    test_assignment_by_levels(Metric::SquaredEuclidean, 500, 2, 0.0, 1000.0f);
+}
+TEST_CASE("Solves cosine assignment by levels by the full problem")
+{
+    test_assignment_by_levels(Metric::Cosine, 100, 3, 0.0);
+}
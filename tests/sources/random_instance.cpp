@@ -0,0 +1,38 @@
+#include <cstddef>
+#include <random>
+
+#include "random_instance.h"
+
+
+RandomInstance::RandomInstance(const unsigned int n,
+                               const unsigned int seed,
+                               const unsigned int greatest_cost)
+    : n(n), C(static_cast<std::size_t>(n) * n), C_row_pointers(n),
+      C_copy(C.size()), C_copy_row_pointers(n)
+{
+    std::mt19937 random(seed);
+    std::uniform_int_distribution<unsigned int> random_cost(0, greatest_cost);
+    for (auto& cost : C) { cost = random_cost(random); }
+
+    for (unsigned int i = 0; i < n; ++i)
+    {
+        C_row_pointers[i]      = &C[static_cast<std::size_t>(i) * n];
+        C_copy_row_pointers[i] = &C_copy[static_cast<std::size_t>(i) * n];
+    }
+}
+
+unsigned int** RandomInstance::copy()
+{
+    C_copy = C;
+    return C_copy_row_pointers.data();
+}
+unsigned long long RandomInstance::total_cost(
+    const std::vector<unsigned int>& assignment) const
+{
+    unsigned long long total = 0;
+    for (unsigned int i = 0; i < n; ++i)
+    {
+        total += C[static_cast<std::size_t>(i) * n + assignment[i]];
+    }
+    return total;
+}
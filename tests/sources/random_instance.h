@@ -0,0 +1,56 @@
+#pragma once
+
+#include <algorithm>
+#include <numeric>
+#include <vector>
+
+
+/// Holds a random nxn cost matrix with pointers to its rows, and a copy for
+/// solvers that modify the costs they are given.
+struct RandomInstance
+{
+    /// Draws costs uniformly from 0..greatest_cost. Instances are
+    /// deterministic: the same arguments always yield the same costs.
+    RandomInstance(unsigned int n,
+                   unsigned int seed,
+                   unsigned int greatest_cost);
+    RandomInstance(const RandomInstance&)            = delete;
+    RandomInstance& operator=(const RandomInstance&) = delete;
+
+    /// Restores the copy to the original costs, and returns its rows.
+    unsigned int** copy();
+    /// Returns the total cost of the specified assignment.
+    unsigned long long total_cost(
+        const std::vector<unsigned int>& assignment) const;
+
+    const unsigned int         n;
+    std::vector<unsigned int>  C;  // Row-major.
+    std::vector<unsigned int*> C_row_pointers;
+
+    private:
+    std::vector<unsigned int>  C_copy;
+    std::vector<unsigned int*> C_copy_row_pointers;
+};
+
+/// Returns the costs of all n! assignments of n workers in increasing order,
+/// by enumeration. Each assignment is given to cost_of as the task of each
+/// worker.
+///
+/// @tparam AssignmentCost
+///     The type of a function-like object:
+///     unsigned long long (*)(const std::vector<unsigned int>& assignment);
+template <typename AssignmentCost>
+std::vector<unsigned long long> ranked_costs_by_enumeration(
+    const unsigned int    n,
+    const AssignmentCost& cost_of)
+{
+    std::vector<unsigned int> assignment(n);
+    std::iota(assignment.begin(), assignment.end(), 0);
+
+    std::vector<unsigned long long> costs;
+    do { costs.push_back(cost_of(assignment)); }
+    while (std::next_permutation(assignment.begin(), assignment.end()));
+
+    std::sort(costs.begin(), costs.end());
+    return costs;
+}
@@ -0,0 +1,72 @@
+#include <limits>
+#include <vector>
+
+#include <catch.hpp>
+
+#include <hungarian_algorithm.h>
+#include <sensitivity.h>
+
+#include "random_instance.h"
+
+
+using rharel::hungarian_algorithm::compute_cost_tolerances;
+using rharel::hungarian_algorithm::solve_for_minimum_cost_assignment;
+using rharel::hungarian_algorithm::unlimited_cost_change;
+
+
+/// Computes the cost tolerances of a random nxn matrix and compares them to
+/// those found by enumeration.
+void test_tolerances(const unsigned int n, const unsigned int seed)
+{
+    RandomInstance instance(n, seed, /* greatest cost: */ 99);
+
+    std::vector<unsigned int> assignment(n);
+    std::vector<long long>    u(n), v(n);
+    const unsigned long long optimum = solve_for_minimum_cost_assignment(
+        n, instance.copy(), assignment.data(), u.data(), v.data()
+    );
+
+    std::vector<unsigned long long>  T(n * n);
+    std::vector<unsigned long long*> T_rows(n);
+    for (unsigned int i = 0; i < n; ++i) { T_rows[i] = &T[i * n]; }
+    compute_cost_tolerances(n, instance.C_row_pointers.data(), 
+                            assignment.data(), u.data(), v.data(), 
+                            T_rows.data());
+
+    for (unsigned int i = 0; i < n; ++i)
+    {
+        for (unsigned int j = 0; j < n; ++j)
+        {
+            // The least cost with worker i assigned task j, or, if it is,
+            // any other task.
+            const bool is_assigned = assignment[i] == j;
+            const unsigned long long alternative = ranked_costs_by_enumeration(
+                n,
+                [&instance, i, j, is_assigned](
+                    const std::vector<unsigned int>& alternative_assignment)
+                {
+                    if ((alternative_assignment[i] == j) == is_assigned)
+                    {
+                        return std::numeric_limits<unsigned long long>::max();
+                    }
+                    return instance.total_cost(alternative_assignment);
+                }
+            ).front();
+            REQUIRE(T[i * n + j] == alternative - optimum);
+        }
+    }
+}
+TEST_CASE("Computes cost tolerances [n = 2]") { test_tolerances(2, 1); }
+TEST_CASE("Computes cost tolerances [n = 5]") { test_tolerances(5, 2); }
+TEST_CASE("Computes cost tolerances [n = 7]") { test_tolerances(7, 3); }
+TEST_CASE("Computes cost tolerances [n = 1]")
+{
+    unsigned int        cost       = 4;
+    unsigned int*       row        = &cost;
+    unsigned int        assignment = 0;
+    long long           u = 4, v = 0;
+    unsigned long long  tolerance;
+    unsigned long long* tolerance_row = &tolerance;
+    compute_cost_tolerances(1, &row, &assignment, &u, &v, &tolerance_row);
+    REQUIRE(tolerance == unlimited_cost_change);
+}
@@ -0,0 +1,118 @@
+#include <vector>
+
+#include <catch.hpp>
+
+#include <hungarian_algorithm.h>
+
+
+using rharel::hungarian_algorithm::Problem;
+using rharel::hungarian_algorithm::Statistics;
+using rharel::hungarian_algorithm::solve_for_minimum_cost_assignment;
+
+
+/// Returns the number of times the specified step was performed.
+unsigned long long count(const Statistics& statistics, const Problem::Step step)
+{
+    return statistics.step_count[static_cast<int>(step)];
+}
+/// Solves for an nxn cost matrix C where C(i, j) = (i + 1) * (j + 1), and
+/// requires that the reported statistics are consistent.
+///
+/// Statistics are only recorded if the library is built with
+/// HUNGARIAN_ALGORITHM_STATISTICS defined, otherwise they must all be zero.
+/// The tests are built with the same definitions as the library (see
+/// "make test-statistics").
+void test_statistics(const unsigned int n)
+{
+    std::vector<unsigned int>  C(n * n);
+    std::vector<unsigned int*> C_row_pointers(n);
+    for (unsigned int i = 0; i < n; ++i)
+    {
+        C_row_pointers[i] = &C[i * n];
+        for (unsigned int j = 0; j < n; ++j) 
+        { 
+            C[i * n + j] = (i + 1) * (j + 1); 
+        }
+    }
+    std::vector<unsigned int> solution(n);
+    Statistics statistics;
+    statistics.adjustment_count = 1;  // Must be reset.
+    solve_for_minimum_cost_assignment(n, C_row_pointers.data(),
+                                      solution.data(), statistics);
+    for (unsigned int i = 0; i < n; ++i) { REQUIRE(solution[i] == n - 1 - i); }
+
+#ifdef HUNGARIAN_ALGORITHM_STATISTICS
+    const bool is_recorded = n > 1;  // Single workers are assigned at once.
+#else
+    const bool is_recorded = false;
+#endif
+    if (!is_recorded)
+    {
+        for (unsigned int s = 0; s < 7; ++s)
+        {
+            REQUIRE(statistics.step_count[s]       == 0);
+            REQUIRE(statistics.step_nanoseconds[s] == 0);
+        }
+        REQUIRE(statistics.augmenting_path_length_sum     == 0);
+        REQUIRE(statistics.augmenting_path_length_maximum == 0);
+        REQUIRE(statistics.adjustment_count               == 0);
+        REQUIRE(statistics.scanned_member_count           == 0);
+        return;
+    }
+    REQUIRE(count(statistics, Problem::Step::One)  == 1);
+    REQUIRE(count(statistics, Problem::Step::Two)  == 1);
+    REQUIRE(count(statistics, Problem::Step::Done) == 0);
+    // Each augmentation is followed by a return to step 3, which also runs
+    // once after step 2.
+    REQUIRE(count(statistics, Problem::Step::Three) ==
+            count(statistics, Problem::Step::Five) + 1);
+    // Each round of step 4 ends in step 5 or step 6.
+    REQUIRE(count(statistics, Problem::Step::Four) ==
+            count(statistics, Problem::Step::Five) +
+            count(statistics, Problem::Step::Six));
+    REQUIRE(statistics.adjustment_count <=
+            count(statistics, Problem::Step::Six));
+
+    const unsigned long long augmentation_count =
+        count(statistics, Problem::Step::Five);
+    REQUIRE(statistics.augmenting_path_length_sum >= augmentation_count);
+    REQUIRE(statistics.augmenting_path_length_maximum <= n);
+    REQUIRE(statistics.scanned_member_count >=
+            static_cast<unsigned long long>(n));
+}
+TEST_CASE("Reports statistics [n =  1]") { test_statistics(1);  }
+TEST_CASE("Reports statistics [n =  5]") { test_statistics(5);  }
+TEST_CASE("Reports statistics [n = 30]") { test_statistics(30); }
+
+TEST_CASE("Stars a maximum matching of zeros in step 2")
+{
+    // Step 1 reduces C to R and assigns only some rows. Completing that
+    // assignment by starring the first free zero of each remaining row
+    // leaves a row unstarred, so the Munkres procedure would have to
+    // augment; starring a maximum matching leaves it nothing to do.
+    const unsigned int n = 3;
+    std::vector<unsigned int> C = { 2, 1, 1,
+                                    0, 0, 2,
+                                    2, 1, 1 };
+    const std::vector<unsigned int> R = { 1, 0, 0,
+                                          0, 0, 2,
+                                          1, 0, 0 };
+    std::vector<unsigned int*> C_row_pointers(n);
+    for (unsigned int i = 0; i < n; ++i) { C_row_pointers[i] = &C[i * n]; }
+
+    Problem problem(n, C_row_pointers.data());
+    problem.step();
+    REQUIRE(problem.next_step() == Problem::Step::Two);
+    REQUIRE(C == R);
+
+    do { REQUIRE(problem.next_step() != Problem::Step::Five); }
+    while (!problem.step());
+    REQUIRE(count(problem.statistics(), Problem::Step::Five) == 0);
+
+    std::vector<unsigned int> solution(n);
+    problem.solve(solution.data());
+    for (unsigned int i = 0; i < n; ++i)
+    {
+        REQUIRE(R[i * n + solution[i]] == 0);
+    }
+}
@@ -0,0 +1,84 @@
+#include <algorithm>
+#include <numeric>
+#include <random>
+#include <vector>
+
+#include <catch.hpp>
+
+#include <hungarian_algorithm.h>
+#include <submatrix_view.h>
+
+#include "random_instance.h"
+
+
+using rharel::hungarian_algorithm::SubmatrixView;
+using rharel::hungarian_algorithm::solve_for_minimum_cost_assignment;
+
+
+TEST_CASE("Solves submatrix views")
+{
+    const unsigned int n = 40, m = 15;
+    const RandomInstance instance(n, /* seed: */ 7, /* greatest cost: */ 999);
+    const unsigned int* const* const C = instance.C_row_pointers.data();
+
+    std::mt19937 random(7);
+    std::vector<unsigned int> rows(n), columns(n);
+    std::iota(rows.begin(),    rows.end(),    0);
+    std::iota(columns.begin(), columns.end(), 0);
+    std::shuffle(rows.begin(),    rows.end(),    random);
+    std::shuffle(columns.begin(), columns.end(), random);
+
+    // Two views of disjoint rows share an output buffer.
+    const SubmatrixView first (C, m, &rows[0], &columns[0]);
+    const SubmatrixView second(C, m, &rows[m], &columns[m]);
+    std::vector<unsigned int> solution(n, n);
+    const unsigned long long first_cost =
+        solve_for_minimum_cost_assignment(first, solution.data());
+    const unsigned long long second_cost =
+        solve_for_minimum_cost_assignment(second, solution.data());
+
+    for (const SubmatrixView* view : { &first, &second })
+    {
+        // Copies the submatrix and solves it with the Munkres procedure.
+        std::vector<unsigned int>  copy(m * m);
+        std::vector<unsigned int*> copy_rows(m);
+        for (unsigned int a = 0; a < m; ++a)
+        {
+            copy_rows[a] = &copy[a * m];
+            for (unsigned int b = 0; b < m; ++b)
+            {
+                copy[a * m + b] = (*view)(a, b);
+            }
+        }
+        std::vector<unsigned int> copy_solution(m);
+        solve_for_minimum_cost_assignment(m, copy_rows.data(),
+                                          copy_solution.data());
+
+        // Maps columns of the matrix to those of the view.
+        std::vector<unsigned int> column_in_view(n, m);
+        for (unsigned int b = 0; b < m; ++b)
+        {
+            column_in_view[view->column(b)] = b;
+        }
+        unsigned long long cost = 0, expected_cost = 0;
+        std::vector<bool> is_taken(m, false);
+        for (unsigned int a = 0; a < m; ++a)
+        {
+            const unsigned int i = view->row(a),
+                               b = column_in_view[solution[i]];
+            REQUIRE(b < m);
+            REQUIRE_FALSE(is_taken[b]);
+            is_taken[b] = true;
+
+            cost          += (*view)(a, b);
+            expected_cost += (*view)(a, copy_solution[a]);
+        }
+        REQUIRE(cost == expected_cost);
+        REQUIRE(cost == (view == &first ? first_cost : second_cost));
+    }
+    // Rows outside both views are untouched.
+    for (unsigned int k = 2 * m; k < n; ++k)
+    {
+        REQUIRE(solution[rows[k]] == n);
+    }
+}
@@ -0,0 +1,90 @@
+#include <chrono>
+#include <vector>
+
+#include <catch.hpp>
+
+#include <hungarian_algorithm.h>
+
+#include "random_instance.h"
+
+
+using rharel::hungarian_algorithm::CancellationToken;
+using rharel::hungarian_algorithm::Problem;
+using rharel::hungarian_algorithm::SolveStatus;
+
+
+/// Generates the random instance the tests below solve.
+RandomInstance budgeted_instance(const unsigned int n)
+{
+    return RandomInstance(n, /* seed: */ n, /* greatest cost: */ 99);
+}
+
+/// Requires that the specified assignment is a permutation of 0..n-1.
+void require_feasible(const std::vector<unsigned int>& assignment)
+{
+    const unsigned int n = static_cast<unsigned int>(assignment.size());
+    std::vector<bool> is_assigned(n, false);
+    for (const unsigned int j : assignment)
+    {
+        REQUIRE(j < n);
+        REQUIRE(!is_assigned[j]);
+        is_assigned[j] = true;
+    }
+}
+/// Solves the specified instance without a budget.
+unsigned long long optimal_cost(const unsigned int n)
+{
+    RandomInstance instance = budgeted_instance(n);
+    std::vector<unsigned int> assignment(n);
+    Problem(n, instance.copy()).solve(assignment.data());
+    return instance.total_cost(assignment);
+}
+
+TEST_CASE("Solves within a generous deadline")
+{
+    const unsigned int n = 40;
+    RandomInstance instance = budgeted_instance(n);
+    std::vector<unsigned int> assignment(n);
+
+    Problem problem(n, instance.copy());
+    const SolveStatus status = problem.solve(
+        assignment.data(),
+        std::chrono::steady_clock::now() + std::chrono::hours(1)
+    );
+    REQUIRE(status == SolveStatus::Optimal);
+    REQUIRE(instance.total_cost(assignment) == optimal_cost(n));
+}
+TEST_CASE("Returns a feasible assignment past the deadline, then resumes")
+{
+    const unsigned int n = 40;
+    RandomInstance instance = budgeted_instance(n);
+    std::vector<unsigned int> assignment(n);
+
+    Problem problem(n, instance.copy());
+    for (unsigned int k = 0; k < 5; ++k) { problem.step(); }
+
+    const SolveStatus status = problem.solve(
+        assignment.data(), std::chrono::steady_clock::now()
+    );
+    REQUIRE(status == SolveStatus::DeadlineExpired);
+    require_feasible(assignment);
+    REQUIRE(instance.total_cost(assignment) >= optimal_cost(n));
+
+    problem.solve(assignment.data());
+    REQUIRE(instance.total_cost(assignment) == optimal_cost(n));
+}
+TEST_CASE("Returns a feasible assignment when cancelled")
+{
+    const unsigned int n = 40;
+    RandomInstance instance = budgeted_instance(n);
+    std::vector<unsigned int> assignment(n);
+
+    CancellationToken token;
+    REQUIRE(!token.is_cancelled());
+    token.cancel();
+    REQUIRE(token.is_cancelled());
+
+    Problem problem(n, instance.copy());
+    REQUIRE(problem.solve(assignment.data(), token) == SolveStatus::Cancelled);
+    require_feasible(assignment);
+}
@@ -0,0 +1,137 @@
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <catch.hpp>
+
+#include <hungarian_algorithm.h>
+#include <tracer.h>
+
+
+using rharel::hungarian_algorithm::Problem;
+using rharel::hungarian_algorithm::TraceScope;
+using rharel::hungarian_algorithm::Tracer;
+using rharel::hungarian_algorithm::find_partial_assignment;
+using rharel::hungarian_algorithm::solve_for_minimum_cost_assignment_lazily;
+
+
+/// Counts the occurrences of a pattern in a string.
+std::size_t count_occurrences(const std::string& text,
+                              const std::string& pattern)
+{
+    std::size_t count = 0;
+    for (std::size_t k = text.find(pattern);
+         k != std::string::npos;
+         k = text.find(pattern, k + 1))
+    {
+        ++ count;
+    }
+    return count;
+}
+/// Writes the tracer's events and requires that spans are balanced.
+std::string require_balanced_trace(const Tracer& tracer)
+{
+    std::ostringstream stream;
+    tracer.write(stream);
+    const std::string trace = stream.str();
+
+    REQUIRE(trace.find("\"traceEvents\":[") != std::string::npos);
+    REQUIRE(count_occurrences(trace, "\"ph\":\"B\"") == tracer.size() / 2);
+    REQUIRE(count_occurrences(trace, "\"ph\":\"E\"") == tracer.size() / 2);
+
+    return trace;
+}
+
+TEST_CASE("Traces Munkres steps")
+{
+    const unsigned int n = 10;
+    std::vector<unsigned int>  C(n * n);
+    std::vector<unsigned int*> C_row_pointers(n);
+    for (unsigned int i = 0; i < n; ++i)
+    {
+        C_row_pointers[i] = &C[i * n];
+        for (unsigned int j = 0; j < n; ++j)
+        {
+            C[i * n + j] = (i + 1) * (j + 1);
+        }
+    }
+    Tracer tracer;
+    Problem problem(n, C_row_pointers.data());
+    problem.trace(&tracer);
+
+    unsigned int step_count = 0;
+    while (!problem.step()) { ++ step_count; }
+    ++ step_count;
+
+    REQUIRE(tracer.size() == 2 * step_count);
+    const std::string trace = require_balanced_trace(tracer);
+    REQUIRE(count_occurrences(trace, "\"name\":\"step_1\"") == 1);
+    REQUIRE(count_occurrences(trace, "\"name\":\"step_2\"") == 1);
+    REQUIRE(count_occurrences(trace, "\"cat\":\"munkres\"") == step_count);
+}
+TEST_CASE("Traces augmentations")
+{
+    const unsigned int n = 20;
+    const auto compute_cost = [](const unsigned int i, const unsigned int j)
+    {
+        return (i + 1) * (j + 1);
+    };
+    std::vector<unsigned int> solution(n);
+    Tracer tracer;
+    solve_for_minimum_cost_assignment_lazily(
+        n, compute_cost, /* cached_row_count: */ 0, solution.data(), &tracer
+    );
+    const std::string trace = require_balanced_trace(tracer);
+    REQUIRE(count_occurrences(trace, "\"name\":\"solve\"") == 1);
+    REQUIRE(count_occurrences(trace, "\"name\":\"initialization\"") == 1);
+
+    // Rows assigned by the initialization need no augmentation.
+    std::vector<unsigned int> partial_assignment(n);
+    std::vector<long long>    u(n), v(n);
+    const unsigned int assigned_count = find_partial_assignment(
+        n, compute_cost, partial_assignment.data(), u.data(), v.data()
+    );
+    REQUIRE(assigned_count > 0);
+    REQUIRE(count_occurrences(trace, "\"name\":\"augmentation\"") 
+            == n - assigned_count);
+}
+TEST_CASE("Restores the formatting of the stream written to")
+{
+    Tracer tracer;
+    {
+        const TraceScope span(&tracer, "task", "test");
+    }
+    std::ostringstream stream;
+    stream << std::scientific << std::setprecision(2);
+    tracer.write(stream);
+
+    REQUIRE((stream.flags() & std::ios_base::floatfield) == 
+            std::ios_base::scientific);
+    REQUIRE(stream.precision() == 2);
+}
+TEST_CASE("Traces spans on separate threads")
+{
+    Tracer tracer;
+    std::vector<std::thread> threads;
+    for (unsigned int t = 0; t < 4; ++t)
+    {
+        threads.emplace_back([&tracer]()
+        {
+            const TraceScope span(&tracer, "task", "test");
+        });
+    }
+    for (auto& thread : threads) { thread.join(); }
+
+    REQUIRE(tracer.size() == 8);
+    const std::string trace = require_balanced_trace(tracer);
+    for (unsigned int t = 0; t < 4; ++t)
+    {
+        const std::string thread = "\"tid\":" + std::to_string(t) + "}";
+        REQUIRE(count_occurrences(trace, thread) == 2);
+    }
+
+    tracer.clear();
+    REQUIRE(tracer.size() == 0);
+}
@@ -0,0 +1,421 @@
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <future>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#ifdef _WIN32
+    #include <fcntl.h>
+    #include <io.h>
+#endif
+
+#include <cost_matrix_file.h>
+#include <hungarian_algorithm.h>
+#include <tracer.h>
+
+
+using namespace rharel::hungarian_algorithm;
+
+
+/// Enumerates the formats of input cost matrices.
+enum class Format : int
+{
+    /// Detected from the first bytes of each input.
+    Automatic = 0,
+    /// Whitespace-separated: n, followed by the n^2 costs in row-major order.
+    Text,
+    /// Cost matrix records (see cost_matrix_file.h).
+    Binary
+};
+/// Enumerates the solver engines.
+enum class Engine : int
+{
+    /// The 6-step Munkres procedure (Problem).
+    Munkres = 0,
+    /// Successive shortest augmenting paths.
+    AugmentingPath
+};
+
+/// Holds command line options.
+struct Options
+{
+    std::vector<std::string> input_paths;  // "-" denotes standard input.
+    Format       format       = Format::Automatic;
+    Engine       engine       = Engine::AugmentingPath;
+    unsigned int thread_count = 1;
+    unsigned int batch_size   = 64;  // Matrices read/solved at a time.
+    std::string  trace_path;         // Empty unless tracing.
+};
+
+/// A cost matrix and its solution.
+struct Instance
+{
+    unsigned int              n = 0;
+    std::vector<unsigned int> costs;       // Row-major.
+    std::vector<unsigned int> assignment;
+    unsigned long long        total_cost = 0;
+};
+
+/// Reads cost matrices from a sequence of inputs, one at a time.
+class InstanceReader
+{
+    public:
+    InstanceReader(const std::vector<std::string>& paths, const Format format)
+        : paths(paths), format(format)
+    {}
+
+    /// Reads the next matrix into the specified instance.
+    /// Returns true iff one was read. Returns false at the end of the last
+    /// input, or on error, in which case failed() reports true.
+    bool next(Instance& instance)
+    {
+        while (true)
+        {
+            if (input == nullptr && !open_next_input()) { return false; }
+
+            if (read(instance)) { return true; }
+            if (has_failed)     { return false; }
+
+            input = nullptr;  // This input is exhausted.
+        }
+    }
+    /// Returns true iff an input could not be opened or parsed.
+    bool failed() const { return has_failed; }
+    /// Describes the error, if any.
+    const std::string& error() const { return error_message; }
+
+    private:
+    /// Opens the next input and determines its format.
+    /// Returns true iff there was one to open.
+    bool open_next_input()
+    {
+        if (next_path_index == paths.size()) { return false; }
+
+        current_path = paths[next_path_index++];
+        if (current_path == "-")
+        {
+            #ifdef _WIN32
+            _setmode(_fileno(stdin), _O_BINARY);
+            #endif
+            input = &std::cin;
+        }
+        else
+        {
+            file.reset(new std::ifstream(current_path, std::ios::binary));
+            if (!*file) { return fail("cannot open"); }
+            input = file.get();
+        }
+
+        current_format = format;
+        if (current_format == Format::Automatic)
+        {
+            current_format = input->peek() == 'H' ? Format::Binary
+                                                  : Format::Text;
+        }
+        if (current_format == Format::Binary)
+        {
+            binary_reader.reset(new CostMatrixStreamReader(*input));
+        }
+        return true;
+    }
+    /// Reads the next matrix from the current input.
+    /// Returns true iff one was read.
+    bool read(Instance& instance)
+    {
+        if (current_format == Format::Binary)
+        {
+            CostMatrixView view;
+            if (!binary_reader->next(view))
+            {
+                return binary_reader->failed() ? fail("invalid record")
+                                               : false;
+            }
+            instance.n = view.size();
+            instance.costs.resize(static_cast<std::size_t>(instance.n) *
+                                  instance.n);
+            for (unsigned int i = 0; i < instance.n; ++i)
+            {
+                for (unsigned int j = 0; j < instance.n; ++j)
+                {
+                    instance.costs[static_cast<std::size_t>(i) * instance.n +
+                                   j] = view(i, j);
+                }
+            }
+            return true;
+        }
+
+        unsigned int n;
+        if (!(*input >> n))
+        {
+            return input->eof() ? false : fail("expected a matrix size");
+        }
+        instance.n = n;
+        instance.costs.resize(static_cast<std::size_t>(n) * n);
+        for (auto& cost : instance.costs)
+        {
+            if (!(*input >> cost)) { return fail("expected a cost"); }
+        }
+        return true;
+    }
+    /// Records an error. Returns false.
+    bool fail(const char* description)
+    {
+        has_failed    = true;
+        error_message = current_path + ": " + description;
+        return false;
+    }
+
+    const std::vector<std::string> paths;
+    const Format                   format;
+
+    std::size_t    next_path_index = 0;
+    std::string    current_path;
+    Format         current_format  = Format::Text;
+    std::istream*  input           = nullptr;
+    std::unique_ptr<std::ifstream>          file;
+    std::unique_ptr<CostMatrixStreamReader> binary_reader;
+
+    bool        has_failed = false;
+    std::string error_message;
+};
+
+/// Solves the specified instance with the specified engine.
+///
+/// The scratch buffer receives a copy of the cost matrix for engines that
+/// modify it. If a tracer is specified, the solve is recorded on it.
+void solve(Instance&                  instance,
+           const Engine               engine,
+           std::vector<unsigned int>& scratch,
+           Tracer* const              tracer)
+{
+    const TraceScope span(tracer, "solve_instance", "task");
+
+    const unsigned int n = instance.n;
+    const unsigned int* const C = instance.costs.data();
+
+    instance.assignment.resize(n);
+    switch (engine)
+    {
+        case Engine::Munkres:
+        {
+            scratch = instance.costs;
+            std::vector<unsigned int*> scratch_rows(n);
+            for (unsigned int i = 0; i < n; ++i)
+            {
+                scratch_rows[i] = &scratch[static_cast<std::size_t>(i) * n];
+            }
+            if (n < 2)
+            {
+                solve_for_minimum_cost_assignment(n, scratch_rows.data(),
+                                                  instance.assignment.data());
+                break;
+            }
+            Problem problem(n, scratch_rows.data());
+            problem.trace(tracer);
+            problem.solve(instance.assignment.data());
+            break;
+        }
+        case Engine::AugmentingPath:
+        {
+            solve_for_minimum_cost_assignment_lazily(
+                n,
+                [C, n](const unsigned int i, const unsigned int j)
+                {
+                    return C[static_cast<std::size_t>(i) * n + j];
+                },
+                /* cached_row_count: */ 0,
+                instance.assignment.data(),
+                tracer
+            );
+            break;
+        }
+    }
+    instance.total_cost = 0;
+    for (unsigned int i = 0; i < n; ++i)
+    {
+        instance.total_cost += C[static_cast<std::size_t>(i) * n +
+                                 instance.assignment[i]];
+    }
+}
+/// Solves a batch of instances on the specified number of threads.
+void solve(std::vector<Instance>& batch,
+           const std::size_t      batch_size,
+           const Engine           engine,
+           const unsigned int     thread_count,
+           Tracer* const          tracer)
+{
+    std::vector<std::thread> threads;
+    for (unsigned int t = 0; t < thread_count; ++t)
+    {
+        threads.emplace_back(
+            [&batch, batch_size, engine, thread_count, t, tracer]()
+        {
+            std::vector<unsigned int> scratch;
+            for (std::size_t k = t; k < batch_size; k += thread_count)
+            {
+                solve(batch[k], engine, scratch, tracer);
+            }
+        });
+    }
+    for (auto& thread : threads) { thread.join(); }
+}
+/// Reads up to batch.size() instances. Returns the number read.
+std::size_t read(InstanceReader&        reader,
+                 std::vector<Instance>& batch,
+                 Tracer* const          tracer)
+{
+    const TraceScope span(tracer, "read_batch", "io");
+
+    std::size_t count = 0;
+    while (count < batch.size() && reader.next(batch[count])) { ++ count; }
+    return count;
+}
+/// Writes the first count solved instances of a batch: one line each,
+/// holding the total cost followed by the assigned task of each worker.
+void write(const std::vector<Instance>& batch, const std::size_t count)
+{
+    std::ostringstream output;
+    for (std::size_t k = 0; k < count; ++k)
+    {
+        output << batch[k].total_cost;
+        for (const unsigned int j : batch[k].assignment) { output << ' ' << j; }
+        output << '\n';
+    }
+    std::cout << output.str();
+    std::cout.flush();
+}
+
+/// Prints usage instructions.
+void print_usage(const char* executable)
+{
+    std::cerr
+        << "Usage: " << executable << " [options] [input...]\n"
+        << "\n"
+        << "Solves the assignment problem for each cost matrix in the\n"
+        << "inputs (standard input if none, or '-'), and writes one line per\n"
+        << "matrix: the minimum total cost, followed by the task assigned to\n"
+        << "each worker.\n"
+        << "\n"
+        << "Options:\n"
+        << "  --format auto|text|binary       Input format (default: auto).\n"
+        << "  --engine munkres|augmenting-path\n"
+        << "                                  Solver (default: augmenting-path).\n"
+        << "  --threads N                     Solver threads (default: 1).\n"
+        << "  --batch N                       Matrices per batch (default: 64).\n"
+        << "  --trace PATH                    Writes a Chrome trace of the run.\n"
+        << "  --help                          Prints this message.\n";
+}
+/// Parses command line options.
+/// Returns true iff they are valid.
+bool parse(const int argc, char** argv, Options& options)
+{
+    for (int a = 1; a < argc; ++a)
+    {
+        const std::string argument = argv[a];
+        const char* const value    = a + 1 < argc ? argv[a + 1] : nullptr;
+
+        if (argument == "--help") { return false; }
+        else if (argument == "--format" && value != nullptr)
+        {
+            const std::string format = argv[++a];
+            if      (format == "auto")   { options.format = Format::Automatic; }
+            else if (format == "text")   { options.format = Format::Text;      }
+            else if (format == "binary") { options.format = Format::Binary;    }
+            else { return false; }
+        }
+        else if (argument == "--engine" && value != nullptr)
+        {
+            const std::string engine = argv[++a];
+            if      (engine == "munkres")
+            {
+                options.engine = Engine::Munkres;
+            }
+            else if (engine == "augmenting-path")
+            {
+                options.engine = Engine::AugmentingPath;
+            }
+            else { return false; }
+        }
+        else if (argument == "--threads" && value != nullptr)
+        {
+            options.thread_count = static_cast<unsigned int>(
+                std::strtoul(argv[++a], nullptr, 10));
+            if (options.thread_count == 0) { return false; }
+        }
+        else if (argument == "--batch" && value != nullptr)
+        {
+            options.batch_size = static_cast<unsigned int>(
+                std::strtoul(argv[++a], nullptr, 10));
+            if (options.batch_size == 0) { return false; }
+        }
+        else if (argument == "--trace" && value != nullptr)
+        {
+            options.trace_path = argv[++a];
+        }
+        else if (argument.size() > 1 && argument[0] == '-' && argument != "-")
+        {
+            return false;
+        }
+        else { options.input_paths.push_back(argument); }
+    }
+    if (options.input_paths.empty()) { options.input_paths.push_back("-"); }
+    return true;
+}
+
+/// Solves batches of cost matrices from files or standard input.
+///
+/// Input is double-buffered: while one batch is being solved, the next is
+/// read and parsed on a separate thread.
+int main(int argc, char** argv)
+{
+    std::ios::sync_with_stdio(false);
+
+    Options options;
+    if (!parse(argc, argv, options))
+    {
+        print_usage(argv[0]);
+        return EXIT_FAILURE;
+    }
+    InstanceReader reader(options.input_paths, options.format);
+
+    std::unique_ptr<Tracer> tracer;
+    if (!options.trace_path.empty()) { tracer.reset(new Tracer()); }
+
+    std::vector<Instance> current(options.batch_size),
+                          next(options.batch_size);
+    std::size_t current_size = read(reader, current, tracer.get());
+    while (current_size > 0)
+    {
+        std::future<std::size_t> next_size = std::async(
+            std::launch::async, [&reader, &next, &tracer]() 
+            { 
+                return read(reader, next, tracer.get()); 
+            }
+        );
+        solve(current, current_size, options.engine, options.thread_count,
+              tracer.get());
+        write(current, current_size);
+
+        current_size = next_size.get();
+        std::swap(current, next);
+    }
+    if (tracer && !tracer->write(options.trace_path.c_str()))
+    {
+        std::cerr << "Error: " << options.trace_path << ": cannot write trace"
+                  << std::endl;
+        return EXIT_FAILURE;
+    }
+    if (reader.failed())
+    {
+        std::cerr << "Error: " << reader.error() << std::endl;
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}